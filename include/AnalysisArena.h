@@ -0,0 +1,115 @@
+#pragma once
+
+#include "llvm/Support/Allocator.h"
+
+#include <cstddef>
+#include <utility>
+
+/* Forward declarations */
+class FunctionNode;
+class HPCParallelPattern;
+class PatternOccurrence;
+class PatternCodeRegion;
+class CallTreeNode;
+class Identification;
+struct ExternalInput;
+struct ExternalOutput;
+struct ExternalInquiry;
+struct InternalLogicalFile;
+struct ExternalInterfaceFile;
+
+/**
+ * The AnalysisArena owns every node that is created while analysing the sources.
+ * Each node class gets its own typed bump allocator, so the nodes of one analysis
+ * lie contiguously in memory and are released in a single bulk operation instead
+ * of being allocated and (never) freed one by one.
+ * Objects created by the arena must not be deleted individually.
+ */
+class AnalysisArena
+{
+public:
+	AnalysisArena();
+
+	~AnalysisArena();
+
+	/**
+	 * @brief Allocates and constructs a new object of type T in the arena.
+	 *
+	 * @param Args The arguments that are forwarded to the constructor of T.
+	 *
+	 * @return The new object. It is owned by the arena.
+	 **/
+	template<typename T, typename... ArgTypes>
+	T* Create(ArgTypes&&... Args)
+	{
+		Pool<T>& TypedPool = GetPool<T>();
+		TypedPool.NumObjects++;
+		return new (TypedPool.Allocator.Allocate()) T(std::forward<ArgTypes>(Args)...);
+	}
+
+	/**
+	 * @brief Returns the number of objects of type T that are alive in the arena.
+	 * Since objects are only released by Reset(), this is the number of objects created since then.
+	 *
+	 * @return The number of objects.
+	 **/
+	template<typename T>
+	size_t GetNumberOfObjects()
+	{
+		return GetPool<T>().NumObjects;
+	}
+
+	/**
+	 * @brief Runs the destructors of all objects in the arena and releases the memory.
+	 * Every pointer handed out by Create() is invalid afterwards.
+	 **/
+	void Reset();
+
+private:
+	/* The allocator of one node class together with the number of objects created in it */
+	template<typename T>
+	struct Pool
+	{
+		llvm::SpecificBumpPtrAllocator<T> Allocator;
+		size_t NumObjects = 0;
+
+		void Reset()
+		{
+			Allocator.DestroyAll();
+			NumObjects = 0;
+		}
+	};
+
+	template<typename T>
+	Pool<T>& GetPool();
+
+	Pool<FunctionNode> FunctionNodes;
+	Pool<HPCParallelPattern> Patterns;
+	Pool<PatternOccurrence> PatternOccurrences;
+	Pool<PatternCodeRegion> PatternCodeRegions;
+	Pool<CallTreeNode> CallTreeNodes;
+	Pool<Identification> Identifications;
+
+	/* One allocator per concrete function point */
+	Pool<ExternalInput> ExternalInputs;
+	Pool<ExternalOutput> ExternalOutputs;
+	Pool<ExternalInquiry> ExternalInquiries;
+	Pool<InternalLogicalFile> InternalLogicalFiles;
+	Pool<ExternalInterfaceFile> ExternalInterfaceFiles;
+
+	/* The arena owns its objects, copies would release them twice */
+	AnalysisArena(const AnalysisArena&);
+	AnalysisArena& operator = (const AnalysisArena&);
+};
+
+template<> inline AnalysisArena::Pool<FunctionNode>& AnalysisArena::GetPool<FunctionNode>() { return FunctionNodes; }
+template<> inline AnalysisArena::Pool<HPCParallelPattern>& AnalysisArena::GetPool<HPCParallelPattern>() { return Patterns; }
+template<> inline AnalysisArena::Pool<PatternOccurrence>& AnalysisArena::GetPool<PatternOccurrence>() { return PatternOccurrences; }
+template<> inline AnalysisArena::Pool<PatternCodeRegion>& AnalysisArena::GetPool<PatternCodeRegion>() { return PatternCodeRegions; }
+template<> inline AnalysisArena::Pool<CallTreeNode>& AnalysisArena::GetPool<CallTreeNode>() { return CallTreeNodes; }
+template<> inline AnalysisArena::Pool<Identification>& AnalysisArena::GetPool<Identification>() { return Identifications; }
+template<> inline AnalysisArena::Pool<ExternalInput>& AnalysisArena::GetPool<ExternalInput>() { return ExternalInputs; }
+template<> inline AnalysisArena::Pool<ExternalOutput>& AnalysisArena::GetPool<ExternalOutput>() { return ExternalOutputs; }
+template<> inline AnalysisArena::Pool<ExternalInquiry>& AnalysisArena::GetPool<ExternalInquiry>() { return ExternalInquiries; }
+template<> inline AnalysisArena::Pool<InternalLogicalFile>& AnalysisArena::GetPool<InternalLogicalFile>() { return InternalLogicalFiles; }
+template<> inline AnalysisArena::Pool<ExternalInterfaceFile>& AnalysisArena::GetPool<ExternalInterfaceFile>() { return ExternalInterfaceFiles; }
@@ -0,0 +1,83 @@
+#pragma once
+
+#include "PatternGraph.h"
+#include "HPCParallelPattern.h"
+#include "PatternPairingValidator.h"
+
+/**
+ * The options of one analysis, usually taken from the command line.
+ */
+struct AnalysisOptions
+{
+	/* Print the tree without function calls */
+	bool OnlyPattern = false;
+
+	/* Do not print any tree */
+	bool NoTree = false;
+
+	/* Print the relation tree in addition to the call tree */
+	bool RelationTree = false;
+
+	/* The maximal depth of the printed trees */
+	int MaxTreeDisplayDepth = 8;
+
+	/* Print repeated subtrees only once and refer back to them afterwards */
+	bool CompactTree = false;
+
+	/* The maximal number of printed children of a node, 0 for no limit */
+	unsigned MaxTreeChildren = 0;
+
+	/* Merge the calls of the same function within the same function or code region into one call tree node */
+	bool MergeCallSites = false;
+
+	/* Stop the traversal at the first Pattern_Begin or Pattern_End that is not paired */
+	bool StopAtFirstError = false;
+
+	/* The number of threads that calculate the statistics, 0 for one per hardware thread */
+	unsigned StatisticThreads = 0;
+};
+
+/**
+ * The AnalysisContext owns the complete state of one analysis: the pattern graph together with its arena and file table,
+ * the call tree, the pattern stacks and the pairing validator that are used while the sources are traversed, and the options.
+ * Every step of the analysis gets the context (or the part of it that it needs) passed explicitly.
+ * There is no global state, so independent analyses can run concurrently in one process as long as each has its own context.
+ */
+class AnalysisContext
+{
+public:
+	explicit AnalysisContext(AnalysisOptions Options = AnalysisOptions());
+
+	PatternGraph& GetGraph() { return this->Graph; }
+
+	CallTree& GetCallTree() { return this->Tree; }
+
+	PatternStack& GetPatternStack() { return this->Stack; }
+
+	PatternPairingValidator& GetPairingValidator() { return this->Pairing; }
+
+	const AnalysisOptions& GetOptions() const { return this->Options; }
+
+	/**
+	 * @brief Forgets all nodes of the analysis, empties the call tree, the pattern stacks and the pairing validator
+	 * and releases the memory of all nodes in one bulk operation. The options are kept.
+	 **/
+	void Clear();
+
+private:
+	AnalysisOptions Options;
+
+	PatternGraph Graph;
+
+	PatternStack Stack;
+
+	/* Reports its errors with the file table of the graph */
+	PatternPairingValidator Pairing;
+
+	/* Creates its nodes in the arena of the graph, so it has to be declared after the graph */
+	CallTree Tree;
+
+	/* The context owns the graph and the arena, copies would release the nodes twice */
+	AnalysisContext(const AnalysisContext&);
+	AnalysisContext& operator = (const AnalysisContext&);
+};
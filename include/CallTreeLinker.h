@@ -0,0 +1,69 @@
+#pragma once
+
+#include "PatternGraph.h"
+
+#include "llvm/ADT/DenseSet.h"
+
+#include <unordered_map>
+#include <vector>
+
+/**
+ * Links the function calls of a CallTree to the declarations of the called functions.
+ *
+ * The call tree is traversed once from the root in depth-first order. Every node is entered at most once, so each
+ * call is linked exactly once and recursive functions are not expanded repeatedly. The linking therefore takes linear
+ * time in the size of the call tree and does not depend on a maximum recursion depth.
+ *
+ * A recursive cycle of functions stays a cycle of callee edges between the declarations, it is not condensed into a
+ * single node.
+ */
+class CallTreeLinker
+{
+public:
+	explicit CallTreeLinker(CallTree* Tree);
+
+	/**
+	 * @brief Links all calls reachable from the root.
+	 *
+	 * @param Root The node the traversal starts with, usually the main function.
+	 **/
+	void Link(CallTreeNode* Root);
+
+private:
+	/**
+	 * A node whose successors are being traversed.
+	 */
+	struct Frame
+	{
+		CallTreeNode* Node;
+		/* The declarations that are traversed after a call, empty for all other nodes */
+		std::vector<CallTreeNode*> Targets;
+		size_t Next;
+	};
+
+	/**
+	 * @brief Marks the node as visited and pushes it on the stack. A call is linked at this point.
+	 **/
+	void Enter(CallTreeNode* Node);
+
+	/**
+	 * @brief Links a call to the declarations it may be dispatched to.
+	 * The first declaration of every called function becomes a callee of the call, as before.
+	 * If a function is defined more than once, the other declarations are traversed, but not linked.
+	 *
+	 * @param Call The call.
+	 * @param Targets The vector the declarations that have to be traversed are added to.
+	 **/
+	void LinkCall(CallTreeNode* Call, std::vector<CallTreeNode*>& Targets);
+
+	void AppendDeclarations(CallTreeNode* Call, FunctionID Function, std::vector<CallTreeNode*>& Targets);
+
+	CallTree* Tree;
+
+	/* The declarations of every function in the order of the declaration vector */
+	std::unordered_map<FunctionID, std::vector<CallTreeNode*>> Declarations;
+
+	llvm::DenseSet<CallTreeNode*> Visited;
+
+	std::vector<Frame> Frames;
+};
@@ -0,0 +1,90 @@
+#pragma once
+
+#include "llvm/ADT/DenseMap.h"
+
+#include <vector>
+
+/* Forward declarations */
+class CallTreeNode;
+
+/**
+ * A summary of the subtree below a CallTreeNode, i.e. of the full expansion of all calls within it.
+ */
+struct CallTreeSubtreeSummary
+{
+	/* True if the expansion contains a Pattern_Begin or Pattern_End node */
+	bool ContainsPatterns = false;
+
+	bool HasPatterns() const { return ContainsPatterns; }
+};
+
+/**
+ * The summaries of the subtrees of a linked CallTree.
+ *
+ * After linking, all calls of a function share the single Function_Decl node of the function, so the call tree is a DAG
+ * whose subtrees are hash-consed by the FunctionID of the declarations. The summary of each shared subtree is computed
+ * once, bottom-up, and reused at every call that references it. A traversal of the full expansion, e.g. for printing,
+ * can consult the summary instead of descending into a subtree that contributes nothing.
+ *
+ * The summaries of the declarations are cached until Clear() is called, i.e. until the tree is changed.
+ * Within a recursive cycle, the expansion is cut at the first call back into the cycle. The summary of a declaration
+ * cut at a call further up the path is incomplete, so it is not cached on its own. Instead, all declarations of the
+ * cycle share the summary of the cycle as seen from the call that reached it first, once that summary is complete.
+ */
+class CallTreeSummaries
+{
+public:
+	/**
+	 * @brief Returns the summary of the subtree below a node.
+	 *
+	 * @param Node The root of the subtree.
+	 *
+	 * @return The summary, including the node itself.
+	 **/
+	CallTreeSubtreeSummary Get(CallTreeNode* Node);
+
+	/**
+	 * @brief Forgets all cached summaries.
+	 **/
+	void Clear();
+
+private:
+	/**
+	 * A node whose callees are being summarised.
+	 */
+	struct Frame
+	{
+		CallTreeNode* Node;
+		size_t Next;
+		CallTreeSubtreeSummary Summary;
+		/* The lowest position on the path at which the expansion of this node was cut */
+		size_t LowestCut;
+		/* The first entry of Pending that was finished below this node */
+		size_t FirstPending;
+	};
+
+	/**
+	 * @brief Starts the summary of a node with the node itself.
+	 **/
+	void Enter(CallTreeNode* Node);
+
+	/**
+	 * @brief Adds the summary of a callee to the summary of its caller.
+	 **/
+	static void Merge(CallTreeSubtreeSummary& Caller, const CallTreeSubtreeSummary& Callee);
+
+	/**
+	 * @brief Only the subtrees of declarations are shared, so only their summaries are cached.
+	 **/
+	static bool IsShared(CallTreeNode* Node);
+
+	llvm::DenseMap<CallTreeNode*, CallTreeSubtreeSummary> Cache;
+
+	/* The position of every node on the current path, i.e. the index of its frame */
+	llvm::DenseMap<CallTreeNode*, size_t> OnPath;
+
+	/* The shared nodes whose expansion was cut further up the path and which wait for the summary of their cycle */
+	std::vector<CallTreeNode*> Pending;
+
+	std::vector<Frame> Frames;
+};
@@ -0,0 +1,92 @@
+#pragma once
+
+#include "llvm/ADT/SmallPtrSet.h"
+
+#include <vector>
+#include <cstddef>
+
+/* Forward declarations */
+class CallTreeNode;
+
+/**
+ * The CalleeList holds the children of a CallTreeNode in the order they appear in the analysed source code.
+ * The callees are stored contiguously and the order is kept stable while nodes are moved between parents.
+ * A hashed membership set makes the duplicate check constant-time, so a node can be inserted at most once.
+ */
+class CalleeList
+{
+public:
+	typedef std::vector<CallTreeNode*>::iterator iterator;
+	typedef std::vector<CallTreeNode*>::const_iterator const_iterator;
+
+	iterator begin() { return Nodes.begin(); }
+	iterator end() { return Nodes.end(); }
+	const_iterator begin() const { return Nodes.begin(); }
+	const_iterator end() const { return Nodes.end(); }
+
+	size_t Size() const { return Nodes.size(); }
+
+	bool Empty() const { return Nodes.empty(); }
+
+	CallTreeNode* operator[](size_t Index) const { return Nodes[Index]; }
+
+	/**
+	 * @brief Checks in constant time if the node is already a callee.
+	 *
+	 * @param Node The node to look for.
+	 *
+	 * @return True if the node is stored in this list.
+	 **/
+	bool Contains(CallTreeNode* Node) const { return Members.count(Node) != 0; }
+
+	/**
+	 * @brief Appends the node after the last callee.
+	 *
+	 * @param Node The new callee.
+	 *
+	 * @return False if the node already is a callee. Else, true.
+	 **/
+	bool PushBack(CallTreeNode* Node);
+
+	/**
+	 * @brief Inserts the node before the given position.
+	 *
+	 * @param Position The index the node has after the insertion.
+	 * @param Node The new callee.
+	 *
+	 * @return False if the node already is a callee. Else, true.
+	 **/
+	bool Insert(size_t Position, CallTreeNode* Node);
+
+	/**
+	 * @brief Returns the position of the node in this list.
+	 *
+	 * @param Node The node to look for.
+	 *
+	 * @return The index of the node or Size() if it is not a callee.
+	 **/
+	size_t IndexOf(CallTreeNode* Node) const;
+
+	/**
+	 * @brief Moves all callees from the index First to the end of this list into another list.
+	 * The moved nodes keep their relative order and are inserted before the position Position of Dest.
+	 * Nodes that already are callees of Dest are only removed from this list.
+	 *
+	 * @param First The index of the first callee that is moved.
+	 * @param Dest The list that receives the callees.
+	 * @param Position The index in Dest the first moved node has after the operation.
+	 *
+	 * @return The number of nodes inserted into Dest.
+	 **/
+	size_t SpliceTail(size_t First, CalleeList& Dest, size_t Position);
+
+	/**
+	 * @brief Removes all callees.
+	 **/
+	void Clear();
+
+private:
+	std::vector<CallTreeNode*> Nodes;
+
+	llvm::SmallPtrSet<CallTreeNode*, 4> Members;
+};
@@ -0,0 +1,75 @@
+#pragma once
+
+#include "llvm/ADT/DenseMap.h"
+
+#include <vector>
+#include <cstddef>
+
+/**
+ * The EdgeSet holds the neighbours of a pattern graph node for one kind of edge.
+ * The neighbours are kept in insertion order, and a hash map from the identity of each neighbour
+ * to the number of times the edge was added makes the duplicate check constant-time.
+ * Two neighbours are considered the same edge if they have the same key. The owner of the set decides on the key,
+ * either the neighbour itself or PatternGraphNode::GetEdgeKey().
+ */
+template<typename NodeType>
+class EdgeSet
+{
+public:
+	typedef typename std::vector<NodeType*>::const_iterator const_iterator;
+
+	const_iterator begin() const { return Nodes.begin(); }
+	const_iterator end() const { return Nodes.end(); }
+
+	size_t Size() const { return Nodes.size(); }
+
+	bool Empty() const { return Nodes.empty(); }
+
+	/**
+	 * @brief The neighbours in the order they were first added.
+	 **/
+	const std::vector<NodeType*>& GetNodes() const { return Nodes; }
+
+	/**
+	 * @brief Adds an edge to the node, unless there already is an edge with the same key.
+	 * In that case only the multiplicity of the existing edge is incremented.
+	 *
+	 * @param Node The neighbour.
+	 * @param Key The identity of the neighbour.
+	 *
+	 * @return True if the edge is new.
+	 **/
+	bool Insert(NodeType* Node, const void* Key)
+	{
+		auto Entry = Multiplicities.insert({Key, 0});
+		Entry.first->second++;
+
+		if (!Entry.second)
+		{
+			return false;
+		}
+
+		Nodes.push_back(Node);
+		return true;
+	}
+
+	bool Contains(const void* Key) const { return Multiplicities.count(Key) != 0; }
+
+	/**
+	 * @brief Returns how often the edge with the given key was added.
+	 *
+	 * @param Key The identity of the neighbour.
+	 *
+	 * @return The multiplicity or 0 if there is no such edge.
+	 **/
+	unsigned GetMultiplicity(const void* Key) const
+	{
+		auto Entry = Multiplicities.find(Key);
+		return Entry != Multiplicities.end() ? Entry->second : 0;
+	}
+
+private:
+	std::vector<NodeType*> Nodes;
+
+	llvm::DenseMap<const void*, unsigned> Multiplicities;
+};
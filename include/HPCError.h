@@ -73,3 +73,30 @@ private:
   std::vector<PatternCodeRegion*> PatternVector;
 
 };
+
+/*
+ * Thrown if a pattern graph cannot be saved or a saved pattern graph cannot be read
+ */
+class GraphFileException: public PInTRuntimeException{
+public:
+  GraphFileException(std::string FileName, std::string Reason);
+  const char* what() const throw();
+private:
+  std::string Message;
+};
+
+/*
+ * Thrown if the string argument of a pattern instrumentation call is malformed
+ */
+class PatternStringException: public PInTRuntimeException{
+public:
+  PatternStringException(std::string PatternString, size_t Position, std::string Reason);
+  const char* what() const throw();
+  /*
+   * The byte offset of the error within the string
+   */
+  size_t GetPosition() const { return this->Position; }
+private:
+  std::string Message;
+  size_t Position;
+};
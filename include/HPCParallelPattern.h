@@ -10,6 +10,7 @@
 
 #include "DesignSpaces.h"
 #include "PatternGraph.h"
+#include "SourceFileTable.h"
 
 #include "visitor/HPCParallelPatternVisitor.h"
 #include "visitor/PatternGraphNodeVisitor.h"
@@ -145,6 +146,16 @@ public:
 	 */
 	const std::set<FunctionPointPointer, FunctionPointComparator>& GetFunctionPoints();
 
+	/**
+	 * @brief All operators counted for the Halstead statistic, see HPCParallelPattern::IncrementNumberOfOperators().
+	 */
+	const std::multiset<std::string>& GetOperators() { return this->Operators; }
+
+	/**
+	 * @brief All operands counted for the Halstead statistic, see HPCParallelPattern::IncrementNumberOfOperands().
+	 */
+	const std::multiset<std::string>& GetOperands() { return this->Operands; }
+
 
 
 private:
@@ -213,7 +224,6 @@ private:
 class PatternCodeRegion : public PatternGraphNode
 {
 public:
-	~PatternCodeRegion();
 	PatternCodeRegion(PatternOccurrence* PatternOcc);
 	
 	/**
@@ -243,29 +253,40 @@ public:
 
 	void AddOnlyPatternParent(PatternGraphNode* PatParent);
 
-	std::vector<PatternGraphNode*> GetChildren() { return this->Children; }
+	const std::vector<PatternGraphNode*>& GetChildren() { return this->Children.GetNodes(); }
 
-	std::vector<PatternCodeRegion*> GetOnlyPatternChildren() { return this->PatternChildren; }
+	const std::vector<PatternCodeRegion*>& GetOnlyPatternChildren() { return this->PatternChildren.GetNodes(); }
 
-	std::vector<PatternGraphNode*> GetParents() { return this->Parents; }
+	const std::vector<PatternGraphNode*>& GetParents() { return this->Parents.GetNodes(); }
 
-	std::vector<PatternCodeRegion*> GetOnlyPatternParents() { return this->PatternParents; }
+	const std::vector<PatternCodeRegion*>& GetOnlyPatternParents() { return this->PatternParents.GetNodes(); }
+
+	unsigned GetChildMultiplicity(PatternGraphNode* Child) { return this->Children.GetMultiplicity(Child->GetEdgeKey()); }
 
 	void SetFirstLine (int FirstLine);
 
 	void SetLastLine (int LastLine);
 
 
-	void SetStartSourceLoc(clang::SourceLocation StartLoc);
+	void SetStartSourceLoc(StableLocation StartLoc);
 
-	void SetEndSourceLoc(clang::SourceLocation EndLoc);
+	void SetEndSourceLoc(StableLocation EndLoc);
 
-	clang::SourceLocation GetStartLoc();
+	/**
+	 * @brief The location of the Pattern_Begin call.
+	 * It stays valid after the AST it was extracted from has been released.
+	 */
+	StableLocation GetStartLoc();
 
-	clang::SourceLocation GetEndLoc();
+	/**
+	 * @brief The end of the Pattern_End call.
+	 */
+	StableLocation GetEndLoc();
 
 	int GetLinesOfCode() { return this->LinesOfCode; }
 
+	void SetLinesOfCode(int LinesOfCode) { this->LinesOfCode = LinesOfCode; }
+
 	std::string GetID() { return this->PatternOcc->GetID(); }
 
 	bool HasNoPatternParents();
@@ -291,20 +312,18 @@ public:
 	 * @since Sept. 6th 2020
 	 * @author Patrick Ziegler
 	 */
-	clang::SourceRange GetSourceRange();
+	StableRange GetSourceRange();
 private:
 	PatternOccurrence* PatternOcc;
 
-	clang::SourceLocation SurLoc;
+	StableLocation StartSLocation;
+	StableLocation EndSLocation;
 
-	clang::SourceLocation StartSLocation;
-	clang::SourceLocation EndSLocation;
 
-
-	std::vector<PatternGraphNode*> Parents;
-	std::vector<PatternGraphNode*> Children;
-	std::vector<PatternCodeRegion*> PatternParents;
-	std::vector<PatternCodeRegion*> PatternChildren;
+	EdgeSet<PatternGraphNode> Parents;
+	EdgeSet<PatternGraphNode> Children;
+	EdgeSet<PatternCodeRegion> PatternParents;
+	EdgeSet<PatternCodeRegion> PatternChildren;
 	std::vector<int> LOCofCallTree;
 	int LinesOfCode = 0;
 
@@ -315,26 +334,46 @@ private:
 
 
 /**
- * The pattern stack is used to keep track of the nesting of patterns and functions.
+ * The pattern stacks keep track of the nesting of the code regions while the sources are traversed.
+ * Each analysis has its own stacks, see AnalysisContext.
  */
-extern std::vector<PatternCodeRegion*> PatternContext;
-/**
-	*The OnlyPatternContext only keeps track of the nesting of patterns.
-	*/
-extern std::vector<PatternCodeRegion*> OnlyPatternContext;
+class PatternStack
+{
+public:
+	void AddToPatternStack(PatternCodeRegion* PatternReg);
 
-extern std::vector<PatternOccurrence*> OccStackForHalstead;
+	void AddToOnlyPatternStack(PatternCodeRegion* PatternCodeReg);
 
-void AddToPatternStack(PatternCodeRegion* PatternOcc);
+	PatternCodeRegion* GetTopPatternStack();
 
-void AddToOnlyPatternStack(PatternCodeRegion* PatternCodeReg);
+	PatternCodeRegion* GetTopOnlyPatternStack();
 
-PatternCodeRegion* GetTopPatternStack();
+	void RemoveFromPatternStack(std::string ID);
 
-PatternCodeRegion* GetTopOnlyPatternStack();
+	void RemoveFromOnlyPatternStack(std::string ID);
 
-void RemoveFromPatternStack(std::string ID);
+	/**
+	 * @brief Empties both stacks.
+	 **/
+	void Clear();
 
-void RemoveFromOnlyPatternStack(std::string ID);
+private:
+	/**
+	 * The pattern stack is used to keep track of the nesting of patterns and functions.
+	 */
+	std::vector<PatternCodeRegion*> PatternContext;
+	/**
+	 *The OnlyPatternContext only keeps track of the nesting of patterns.
+	 */
+	std::vector<PatternCodeRegion*> OnlyPatternContext;
+};
 
-PatternCodeRegion* PatternIDisUsed(std::string ID);
+/**
+ * @brief Looks up a code region of the graph by the identifier of its occurrence.
+ *
+ * @param Graph The graph of the analysis.
+ * @param ID The identifier.
+ *
+ * @return The first code region with this identifier or NULL.
+ **/
+PatternCodeRegion* PatternIDisUsed(PatternGraph* Graph, std::string ID);
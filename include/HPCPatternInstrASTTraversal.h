@@ -2,6 +2,7 @@
 
 #include "HPCPatternInstrHandler.h"
 #include "HPCParallelPattern.h"
+#include "SourceFileTable.h"
 
 #include "clang/Frontend/FrontendActions.h"
 #include "clang/AST/ASTConsumer.h"
@@ -13,8 +14,8 @@
 #include "clang/AST/Comment.h"
 #include "clang/AST/Expr.h"
 #include "clang/AST/Decl.h"
-#include "clang/ASTMatchers/ASTMatchers.h"
-#include "clang/ASTMatchers/ASTMatchFinder.h"
+#include "clang/Basic/IdentifierTable.h"
+#include "llvm/ADT/DenseMap.h"
 
 
 #define PATTERN_BEGIN_C_FNNAME "PatternInstrumentation_Pattern_Begin"
@@ -23,6 +24,8 @@
 #define PATTERN_BEGIN_CXX_FNNAME "Pattern_Begin"
 #define PATTERN_END_CXX_FNNAME "Pattern_End"
 
+class PatternStringException;
+
 #define PatternMap std::map<clang::CallExpr*, PatternCodeRegion*>
 
 #include "HPCPatternStatistics.h"
@@ -36,7 +39,7 @@
 class HPCPatternInstrVisitor : public clang::RecursiveASTVisitor<HPCPatternInstrVisitor>
 {
 public:
-	explicit HPCPatternInstrVisitor(clang::ASTContext *Context);
+	HPCPatternInstrVisitor(clang::ASTContext *Context, AnalysisContext* Analysis);
 
 	bool VisitFunctionDecl(clang::FunctionDecl *Decl);
 
@@ -62,17 +65,85 @@ public:
 	 */
 	std::shared_ptr<PatternMap> GetPatternEnd();
 private:
+	/**
+	 * @brief Returns the function node for a declaration of the current translation unit.
+	 * All redeclarations of a function share their canonical declaration, so each function is hashed once per translation unit.
+	 *
+	 * @param Decl Any declaration of the function.
+	 *
+	 * @return The function node, which is registered if necessary.
+	 **/
+	FunctionNode* LookupFunctionNode(clang::FunctionDecl* Decl);
+
+	/**
+	 * @brief Checks if a call is dispatched at runtime, i.e. it is an unqualified call of a virtual method.
+	 *
+	 * @param CallExpr The call expression.
+	 *
+	 * @return True for a virtual call.
+	 **/
+	static bool IsVirtualCall(clang::CallExpr* CallExpr);
+
+	/**
+	 * The calls VisitCallExpr() distinguishes.
+	 */
+	enum InstrumentationCall { NoInstrumentation, PatternBeginCall, PatternEndCall };
+
+	/**
+	 * @brief Recognizes the instrumentation functions by their identifier, which is compared by address.
+	 *
+	 * @param Callee The called function.
+	 *
+	 * @return The kind of instrumentation call, or NoInstrumentation for any other function.
+	 **/
+	InstrumentationCall GetInstrumentationCall(const clang::FunctionDecl* Callee) const;
+
+	/**
+	 * @brief Reads the string literal passed as first argument of an instrumentation call.
+	 * Implicit casts, parentheses and the construction of a string object from the literal are skipped.
+	 *
+	 * @param CallExpr The instrumentation call.
+	 *
+	 * @throw TerminateEarlyException if the argument is not a string literal.
+	 *
+	 * @return The string literal.
+	 **/
+	const clang::StringLiteral* GetPatternString(clang::CallExpr* CallExpr);
+
+	/**
+	 * @brief Prints a malformed pattern string with the source location of the invalid character.
+	 *
+	 * @param PatternStr The string literal of the instrumentation call.
+	 * @param Error The error raised by the tokenizer.
+	 **/
+	void ReportPatternStringError(const clang::StringLiteral* PatternStr, const PatternStringException& Error);
 
 	clang::ASTContext *Context;
+
 	/**
- 	 * This is a match finder to extract the string argument from the pattern instrumentation call and pass it to the HPCPatternBeginInstrHandler
- 	 */
-	clang::ast_matchers::MatchFinder PatternBeginFinder;
+	 * The analysis the extracted patterns, functions and call tree nodes are registered in.
+	 */
+	AnalysisContext* Analysis;
 
 	/**
- 	 * See HPCPatternInstrVisitor::PatternBeginFinder
- 	 */
-	clang::ast_matchers::MatchFinder PatternEndFinder;
+	 * Maps the canonical declarations of this translation unit to their function nodes.
+	 */
+	llvm::DenseMap<const clang::FunctionDecl*, FunctionNode*> FunctionNodes;
+
+	/**
+	 * Translates the locations of the instrumentation calls before they are stored in the PatternCodeRegions.
+	 */
+	StableLocationTranslator Locations;
+
+	/**
+	 * The identifiers of the C and C++ instrumentation functions, resolved once per translation unit.
+	 */
+	const clang::IdentifierInfo* PatternBeginIdentifiers[2];
+
+	/**
+	 * See HPCPatternInstrVisitor::PatternBeginIdentifiers
+	 */
+	const clang::IdentifierInfo* PatternEndIdentifiers[2];
 
 	HPCPatternBeginInstrHandler PatternBeginHandler;
 	HPCPatternEndInstrHandler PatternEndHandler;
@@ -1,34 +1,41 @@
 #pragma once
 
 #include "HPCParallelPattern.h"
+#include "AnalysisContext.h"
 
-#include "clang/ASTMatchers/ASTMatchers.h"
-#include "clang/ASTMatchers/ASTMatchFinder.h"
-
+#include "llvm/ADT/StringRef.h"
 
 /**
- * This class handles the callback that is issued when a pattern begin instrumentation call is encountered and the string argument is matched.
+ * This class handles a pattern begin instrumentation call with the string argument read by the HPCPatternInstrVisitor.
  * It extracts all information about the pattern and patternoccurrence from the string argument and initiates creation of all involved objects.
  */
-class HPCPatternBeginInstrHandler : public clang::ast_matchers::MatchFinder::MatchCallback
+class HPCPatternBeginInstrHandler
 {
 public:
+	explicit HPCPatternBeginInstrHandler(AnalysisContext* Analysis) : Analysis(Analysis), CurrentFnEntry(NULL) {}
+
 	void SetCurrentFnEntry(FunctionNode* FnEntry);
 	/**
 	 * returns the pattern on top of the pattern stack. Is used to keept track within wich pattern we are while traversing.
 	 */
-	PatternCodeRegion* GetLastPattern() { return GetTopPatternStack(); };
+	PatternCodeRegion* GetLastPattern() { return Analysis->GetPatternStack().GetTopPatternStack(); };
 	/**
-	 * @brief Analyse the match results from the pattern begin matcher to extract information about the pattern.
+	 * @brief Analyse the string argument of the pattern begin call to extract information about the pattern.
 	 * After extracting design space, pattern name and pattern identifier, HPCParallelPattern and PatternOccurrence objects are looked up in the database.
 	 * If they do not already exist, they are created.
 	 * Then, a PatternCodeRegion object is created for this particular encounter.
 	 *
-	 * @param Result Match results from the pattern begin matcher.
+	 * @param PatternString The content of the string literal, see ParsePatternBeginString().
+	 *
+	 * @throw PatternStringException if the string is malformed.
 	 **/
-	virtual void run (const clang::ast_matchers::MatchFinder::MatchResult &Result);
+	void run (llvm::StringRef PatternString);
 
 private:
+	/**
+	 * The analysis the patterns are registered in.
+	 */
+	AnalysisContext* Analysis;
 	/**
 	 * Is used to keep track within which function we are while traversing.
 	 */
@@ -39,9 +46,11 @@ private:
 /**
  * See HPCPatternBeginInstrHandler and HPCPatternEndInstrHandler::run()
  */
-class HPCPatternEndInstrHandler : public clang::ast_matchers::MatchFinder::MatchCallback
+class HPCPatternEndInstrHandler
 {
 public:
+	explicit HPCPatternEndInstrHandler(AnalysisContext* Analysis) : Analysis(Analysis), CurrentFnEntry(NULL), LastPattern(NULL), LastOnlyPattern(NULL) {}
+
 	void SetCurrentFnEntry(FunctionNode* FnEntry);
 	/**
 	 * Pattern end is closing a Pattern. Possibly a pattern within another pattern. This is used to get the outer pattern.
@@ -52,13 +61,14 @@ public:
 	 */
 	std::string GetLastPatternID(){ return LastPatternID;};
 	/**
-	 * @brief Extracts the pattern identifier string from the match results and removes the PatternCodeRegion from the pattern stack.
+	 * @brief Takes the pattern identifier from the string argument and removes the PatternCodeRegion from the pattern stack.
 	 *
-	 * @param Result Match results from the pattern end matcher.
+	 * @param PatternString The content of the string literal.
 	 **/
-	virtual void run (const clang::ast_matchers::MatchFinder::MatchResult &Result);
+	void run (llvm::StringRef PatternString);
 
 private:
+	AnalysisContext* Analysis;
 	/**
 	 * @brief See PatternBeginInstrHandler::SetCurrentFnEntry().
 	 *
@@ -33,6 +33,79 @@ public:
  	 * Export the statistic value(s) to a csv file.
  	 */
 	virtual void CSVExport(std::string FileName) = 0;
+
+protected:
+	/**
+	 * @brief Constructor for the statistics of one analysis.
+	 *
+	 * @param myGraph The pattern graph the statistic is calculated for.
+	 **/
+	explicit HPCPatternStatistic(PatternGraph* myGraph) : Graph(myGraph) {}
+
+	/**
+	 * @brief Returns the frozen pattern graph. The graph is frozen now if this has not happened yet.
+	 *
+	 * @return The snapshot of the pattern graph.
+	 **/
+	const PatternGraphSnapshot& GetSnapshot();
+
+	/**
+	 * The pattern graph the statistic is calculated for.
+	 */
+	PatternGraph* Graph;
+};
+
+/**
+ * Abstract class for statistics that calculate a result for each pattern, independently of the other patterns.
+ * The calculation is split into steps, so the patterns can be distributed over several threads, see StatisticScheduler:
+ * BeginCalculation() fixes the patterns, CalculatePatterns() calculates the results of a range of patterns and
+ * EndCalculation() stores the results in the order of the patterns. Different ranges may be calculated concurrently.
+ */
+class PerPatternStatistic : public HPCPatternStatistic
+{
+public:
+	/**
+	 * @brief Calculates the results of all patterns in the calling thread.
+	 **/
+	void Calculate();
+
+	/**
+	 * @brief Fixes the patterns the results are calculated for. The graph is frozen now if this has not happened yet.
+	 **/
+	void BeginCalculation();
+
+	/**
+	 * @brief Calculates the results of the patterns with the indices [Begin, End).
+	 **/
+	void CalculatePatterns(size_t Begin, size_t End);
+
+	/**
+	 * @brief Stores the results of all patterns.
+	 **/
+	void EndCalculation();
+
+	size_t GetNumPatterns() const { return this->Patterns.size(); }
+
+protected:
+	explicit PerPatternStatistic(PatternGraph* myGraph) : HPCPatternStatistic(myGraph) {}
+
+	/**
+	 * @brief Makes room for the results of the patterns, called by BeginCalculation().
+	 **/
+	virtual void PrepareResults(size_t NumPatterns) = 0;
+
+	/**
+	 * @brief Calculates the result of the pattern with the index.
+	 * It may run concurrently for other patterns, so it must only write the result of this index.
+	 **/
+	virtual void CalculatePattern(size_t Index, HPCParallelPattern* Pattern) = 0;
+
+	/**
+	 * @brief Stores the result of the pattern with the index, called by EndCalculation() in the order of the patterns.
+	 **/
+	virtual void StoreResult(size_t Index, HPCParallelPattern* Pattern) = 0;
+
+	std::vector<HPCParallelPattern*> Patterns;
 };
 
 
@@ -48,7 +121,7 @@ public:
 class CyclomaticComplexityStatistic : public HPCPatternStatistic
 {
 public:
-	CyclomaticComplexityStatistic();
+	explicit CyclomaticComplexityStatistic(PatternGraph* myGraph);
 
 	/**
 	 * @brief Calls CyclomaticComplexityStatistic::CountEdges(), CyclomaticComplexityStatistic::CountNodes() and CyclomaticComplexityStatistic::CountConnectedComponents() to calculate the Cyclomatic Complexity Statistic C = (Edges - Nodes) + 2 * ConnectedComponents
@@ -68,35 +141,21 @@ public:
 private:
 
 	/**
-	 * @brief Set a node to visited for calculation of the number of edges in the pattern tree.
-	 *
-	 * @param Node The node that is set visited.
-	 **/
-	void SetNodeVisited(PatternGraphNode* Node);
-	/**
-	 * @brief Enquire if the node is visited (see CyclomaticComplexityStatistic::SetNodeVisited()).
-	 *
-	 * @param Node Node that is checked.
-	 *
-	 * @return True if visited, false else.
-	 **/
-	bool IsNodeVisited(PatternGraphNode* Node);
-
-	std::vector<PatternGraphNode*> VisitedNodes;
-	/**
-	 * @brief Calls CyclomaticComplexityStatistic::CountEdges(PatternGraphNode*) with the entries of all functions in the FunctionDeclDatabase.
+	 * @brief Calls CyclomaticComplexityStatistic::CountEdges(PatternGraphSnapshot::NodeIndex, std::vector<bool>&) with the entries of all functions in the FunctionDeclDatabase.
 	 *
 	 * @return The number of edges in the pattern tree.
 	 **/
 	int CountEdges();
 	/**
-	 * @brief Counts the number of edges in the pattern tree (Disregarding function calls) recursively.
+	 * @brief Counts the number of edges in the pattern tree (Disregarding function calls) beginning from a node.
+	 * Nodes that have already been visited are not descended into again.
 	 *
-	 * @param Current The node with which the counting starts.
+	 * @param Root The node with which the counting starts.
+	 * @param Visited The nodes of the snapshot that have been visited so far.
 	 *
 	 * @return The number of edges.
 	 **/
-	int CountEdges(PatternGraphNode* Root);
+	int CountEdges(PatternGraphSnapshot::NodeIndex Root, std::vector<bool>& Visited);
 	/**
 	 * @brief Counts the number of nodes in the pattern tree (i.e. only PatternCodeRegions) by requesting from the HPCPatternDatabase.
 	 *
@@ -104,7 +163,7 @@ private:
 	 **/
 	int CountNodes();
 	/**
-	 * @brief Connected components are marked by call of GraphAlgorithms::MarkConnectedComponents().
+	 * @brief The connected components are marked when the graph is frozen, see PatternGraphSnapshot::GetConnectedComponent().
 	 * Then, the number of connected components is calculated.
 	 *
 	 * @return The number of connected components.
@@ -125,6 +184,8 @@ private:
 class LinesOfCodeStatistic : public HPCPatternStatistic
 {
 public:
+	explicit LinesOfCodeStatistic(PatternGraph* myGraph);
+
 	void Calculate();
 	/**
 	 * @brief Prints statistics about lines of code for each HPCParallelPattern and PatternOccurrence.
@@ -145,7 +206,7 @@ public:
 class SimplePatternCountStatistic : public HPCPatternStatistic
 {
 public:
-	SimplePatternCountStatistic();
+	explicit SimplePatternCountStatistic(PatternGraph* myGraph);
 	/**
 	 * @brief Dummy function.
 	 */
@@ -175,9 +236,10 @@ public:
 	/**
 	 * @brief Constructor for the Fan-In Fan-Out statistic.
 	 *
+	 * @param myGraph The pattern graph the statistic is calculated for.
 	 * @param maxdepth The maximum recursion depth when descending in the tree.
 	 **/
-	FanInFanOutStatistic(int maxdepth);
+	FanInFanOutStatistic(PatternGraph* myGraph, int maxdepth);
 	/**
 	 * @brief Calculates the Fan-In and Fan-Out statistic for each Pattern.
 	 * First, all children and parents for all PatternOccurrence and PatternCodeRegions are gathered.
@@ -252,7 +314,7 @@ private:
 class Halstead : public HPCPatternStatistic{
 public:
 
-	Halstead();
+	explicit Halstead(PatternGraph* myGraph);
 
 	void Calculate();
 
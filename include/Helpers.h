@@ -5,6 +5,7 @@
 #include <vector>
 #include <string>
 #include <sstream>
+#include <iostream>
 
 /**
  * Has to be redefined here for some godforsaken reasons, otherwise the CSVPrint template complains.
@@ -27,10 +28,6 @@ namespace PatternHelpers
 namespace GraphAlgorithms
 {
 
-	extern void MarkConnectedComponents();
-
-	extern void MarkConnectedComponents(PatternGraphNode* Node, int ComponentID);
-
 	/**
 	 * Calculates all parent pattern code regions of the provided code regions.
 	 * @param Start The current code region.
@@ -57,19 +54,36 @@ namespace SetAlgorithms
 
 namespace Preconditions
 {
+	/**
+	 * @brief Prints the message of the exception and throws it.
+	 * It is separate from the checks below, so these stay small enough to be inlined.
+	 *
+	 * @param Exception is thrown with its dynamic type.
+	 */
+	template<typename ExceptionType> [[noreturn]] void Fail(const ExceptionType& Exception){
+		std::cerr << Exception.what() << std::endl;
+		throw Exception;
+	}
+
 	/**
  	 * @brief An easy way to apply sanity checks.
 	 * Inspired by the Guava preconditions, this function will check if a given condition is satisfied.
  	 * If it is not, then an exception will be thrown.<br>
  	 * The purpose of this function to catch simple errors inside the code, like modifying array elements
  	 * outside of its range, before they lead to segmentation faults.
+ 	 * The message is only built if the condition is violated, so a satisfied check neither allocates nor
+ 	 * constructs an exception.
  	 *
+ 	 * @tparam ExceptionType the type of the exception, e.g. std::out_of_range.
  	 * @param Condition a condition that is expected to be satisifed.
- 	 * @param Exception is thrown when the condition is violated.
+ 	 * @param Message returns the message of the exception. It is only called when the condition is violated.
  	 * @since September 3rd, 2020
  	 * @author Patrick Ziegler
  	 */
-	extern void CheckArgument(bool Condition, std::exception Exception);
+	template<typename ExceptionType, typename MessageFactory> inline void CheckArgument(bool Condition, MessageFactory Message){
+		if(!Condition)
+			Fail(ExceptionType(Message()));
+	}
 }
 
 namespace IO
@@ -0,0 +1,122 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+class AnalysisArena;
+class SimilarityMeasure;
+
+/**
+ * Collects the memory usage of an analysis for the -memReport option.
+ * For every node class the number of live objects in the AnalysisArena and their size are reported,
+ * together with the similarity pairs of the similarity measures.
+ * The objects are counted by their own size, memory owned by their members (e.g. vectors of children) is not included.
+ *
+ * In addition, the peak resident set size is measured for every phase of the analysis.
+ * On Linux, the peak is reset at the beginning of a phase, so the value belongs to this phase alone.
+ * Where this is not possible, the peak since the start of the process is reported and the phase is marked as cumulative.
+ *
+ * A disabled report ignores all calls, so the phases can be marked unconditionally.
+ */
+class MemoryReport
+{
+public:
+	explicit MemoryReport(bool myEnabled);
+
+	bool IsEnabled() const { return this->Enabled; }
+
+	/**
+	 * @brief Starts a new phase of the analysis. The previous phase is ended if necessary.
+	 *
+	 * @param Name The name of the phase.
+	 **/
+	void BeginPhase(const std::string& Name);
+
+	/**
+	 * @brief Ends the current phase and records its peak resident set size.
+	 **/
+	void EndPhase();
+
+	/**
+	 * @brief Counts the live objects of every node class in the arena.
+	 * Replaces the counts of a previous call.
+	 *
+	 * @param Arena The arena of the analysis.
+	 **/
+	void RecordArena(AnalysisArena& Arena);
+
+	/**
+	 * @brief Counts the similarity pairs calculated by a similarity measure.
+	 *
+	 * @param Label The name of the similarity measure.
+	 * @param Measure The similarity measure after SimilarityMeasure::Calculate().
+	 **/
+	void RecordSimilarityPairs(const std::string& Label, SimilarityMeasure& Measure);
+
+	/**
+	 * @brief Prints the object counts and the peak resident set size of every phase.
+	 **/
+	void Print();
+
+	/**
+	 * @brief CSV export of the object counts. Format "Class, Count, Bytes".
+	 *
+	 * @param FileName File name of the output file.
+	 **/
+	void CSVExport(std::string FileName);
+
+	/**
+	 * @brief CSV export of the phases. Format "Phase, PeakRSS, Cumulative".
+	 *
+	 * @param FileName File name of the output file.
+	 **/
+	void CSVExportPhases(std::string FileName);
+
+private:
+	struct ObjectCount
+	{
+		std::string Class;
+		size_t Count;
+		size_t Bytes;
+	};
+
+	struct PhaseUsage
+	{
+		std::string Name;
+		/* Peak resident set size in bytes */
+		size_t PeakRSS;
+		/* True if the peak could not be reset at the beginning of the phase */
+		bool Cumulative;
+	};
+
+	template<typename T>
+	void AddObjects(AnalysisArena& Arena, const std::string& Class);
+
+	/**
+	 * @brief Resets the peak resident set size of the process to the current resident set size.
+	 *
+	 * @return true if the peak has been reset.
+	 **/
+	static bool ResetPeakRSS();
+
+	/**
+	 * @brief Reads the peak resident set size of the process.
+	 *
+	 * @return The peak in bytes, or 0 if it is unknown.
+	 **/
+	static size_t ReadPeakRSS();
+
+	bool Enabled;
+
+	std::vector<ObjectCount> Objects;
+
+	std::vector<ObjectCount> SimilarityPairs;
+
+	std::vector<PhaseUsage> Phases;
+
+	/* The name of the phase that is currently running, empty if there is none */
+	std::string CurrentPhase;
+
+	bool CurrentPhaseCumulative = false;
+};
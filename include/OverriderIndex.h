@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+/* Same as in PatternGraph.h */
+typedef uint64_t FunctionID;
+
+/**
+ * An index of the class hierarchy for the resolution of virtual calls.
+ * It maps each virtual method to the methods directly overriding it. The methods are identified by their
+ * FunctionID, so the overriders found in different translation units are merged.
+ * The index is filled while the sources are traversed and is used to link the virtual calls in the CallTree.
+ */
+class OverriderIndex
+{
+public:
+	/**
+	 * @brief Registers a method as direct overrider of another method. Duplicates are ignored.
+	 *
+	 * @param Overridden The method of the base class.
+	 * @param Overrider The method of the derived class.
+	 **/
+	void AddOverrider(FunctionID Overridden, FunctionID Overrider);
+
+	/**
+	 * @brief Collects all methods a virtual call of the method may be dispatched to.
+	 * These are the method itself and all direct and indirect overriders. Each candidate is visited once.
+	 * The method comes first, followed by the overriders in depth-first order.
+	 *
+	 * @param Method The statically called method.
+	 * @param Candidates The vector the candidates are appended to.
+	 **/
+	void GetDispatchCandidates(FunctionID Method, std::vector<FunctionID>& Candidates) const;
+
+	/**
+	 * @return True if no overriders have been registered.
+	 **/
+	bool IsEmpty() const { return Overriders.empty(); }
+
+	void Clear() { Overriders.clear(); }
+
+private:
+	std::unordered_map<FunctionID, std::vector<FunctionID>> Overriders;
+};
@@ -1,18 +1,30 @@
 #pragma once
 
 #include "DesignSpaces.h"
+#include "AnalysisArena.h"
+#include "CalleeList.h"
+#include "SourceFileTable.h"
+#include "PatternGraphSnapshot.h"
+#include "EdgeSet.h"
+#include "OverriderIndex.h"
+#include "CallTreeSummaries.h"
 
 #include <string>
 #include <vector>
+#include <cstdint>
 #include <stack>
 #include <queue>
 #include "clang/AST/Decl.h"
+#include "clang/AST/DeclCXX.h"
 #include "llvm/Support/Casting.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/StringMap.h"
+#include <unordered_map>
 #include <map>
+#include <memory>
 #include <iostream>
 
 #include "visitor/PatternGraphNodeVisitor.h"
-#include "visitor/CallTreeVisitor.h"
 
 
 //#define TOOMANYBEGINSDEBUG
@@ -29,7 +41,6 @@ class CallTreeNode;
 /**
  * This abstract class is a prototype for all pattern graph node classes following.
  * Descendants have to implement functionality to manage parents and children in the pattern tree/graph.
- * Also, some variables about the connected components are saved in this class.
  */
 class PatternGraphNode {
 public:
@@ -49,7 +60,7 @@ public:
 
 	PatternGraphNode(GraphNodeKind OK) : Kind(OK)
 	{
-		this->ComponentID = -1;
+
 	}
 
 	/**
@@ -66,32 +77,62 @@ public:
 
 	virtual void AddParent(PatternGraphNode* Parent) = 0;
 
-	virtual std::vector<PatternGraphNode*> GetChildren() = 0;
+	virtual const std::vector<PatternGraphNode*>& GetChildren() = 0;
 
-	virtual std::vector<PatternGraphNode*> GetParents() = 0;
+	virtual const std::vector<PatternGraphNode*>& GetParents() = 0;
 
-	void SetConnectedComponent(int CID) { this->ComponentID = CID; }
+	/**
+	 * @brief Returns how often the edge to the child was added to this node.
+	 *
+	 * @param Child A child of this node.
+	 *
+	 * @return The multiplicity of the edge or 0 if it is not a child.
+	 **/
+	virtual unsigned GetChildMultiplicity(PatternGraphNode* Child) = 0;
 
-	int GetConnectedComponent() { return this->ComponentID; }
+	/**
+	 * @brief The identity of this node when it is added as a neighbour of another node.
+	 * Code regions with the same identifier belong to the same PatternOccurrence and share a key,
+	 * every function node is its own key.
+	 *
+	 * @return The key used by the EdgeSet of the neighbour.
+	 **/
+	const void* GetEdgeKey();
+
+	/**
+	 * @brief The index of this node in the PatternGraphSnapshot, see PatternGraphSnapshot::Contains().
+	 **/
+	unsigned GetSnapshotIndex() const { return this->SnapshotIndex; }
+
+	void SetSnapshotIndex(unsigned Index) { this->SnapshotIndex = Index; }
 
 private:
-	int ComponentID;
+	unsigned SnapshotIndex = PatternGraphSnapshot::InvalidIndex;
 
 	const GraphNodeKind Kind;
 };
 
 
 
+/**
+ * Identifies a function across translation units.
+ * It is a 64-bit hash of the Unified Symbol Resolution (USR) of the function declaration.
+ * The value 0 is never assigned to a function.
+ */
+typedef uint64_t FunctionID;
+
+
+
 /**
  * A FunctionNode is a node in the pattern graph (i.e. inherits from PatternGraphNode), and has children and parents.
- * It contains a hash value to uniquely identify a function declaration across compilation-units.
+ * It contains a FunctionID to uniquely identify a function declaration across compilation-units.
  * This is useful if a function is called and we need information from the function body but the function is not defined within the current translation unit.
  * Then, the reference is saved for later until the definition belonging to the function declaration is encountered.
  */
 class FunctionNode : public PatternGraphNode
 {
 public:
-	FunctionNode (std::string Name, unsigned Hash);
+	FunctionNode (std::string Name, FunctionID Hash);
 
 	/**
 	 * The entry point for the pattern visitor.
@@ -113,9 +154,9 @@ public:
 
 	void AddPatternChild(PatternGraphNode* PatChild);
 
-	std::vector<PatternCodeRegion*> GetPatternParents();
+	const std::vector<PatternCodeRegion*>& GetPatternParents();
 
-	std::vector<PatternCodeRegion*> GetPatternChildren();
+	const std::vector<PatternCodeRegion*>& GetPatternChildren();
 
 	bool HasNoPatternParents();
 
@@ -125,17 +166,22 @@ public:
 
 	void PrintVecOfPattern(std::vector<PatternCodeRegion*> RegionVec);
 
-	std::vector<PatternGraphNode*> GetChildren()
+	const std::vector<PatternGraphNode*>& GetChildren()
+	{
+		return Children.GetNodes();
+	}
+
+	const std::vector<PatternGraphNode*>& GetParents()
 	{
-		return Children;
+		return Parents.GetNodes();
 	}
 
-	std::vector<PatternGraphNode*> GetParents()
+	unsigned GetChildMultiplicity(PatternGraphNode* Child)
 	{
-		return Parents;
+		return Children.GetMultiplicity(Child);
 	}
 
-	unsigned GetHash()
+	FunctionID GetHash()
 	{
 		return Hash;
 	}
@@ -154,25 +200,33 @@ public:
 		CorrespondingCallTreeNodes.push_back(Node);
 	}
 
+	std::vector<CallTreeNode*>* getCorrespondingCallTreeNodes(){return &CorrespondingCallTreeNodes;}
+
 private:
 	std::string FnName;
-	unsigned Hash;
+	FunctionID Hash;
 	// we need only one Parents to trace down the reletion chip of the patterns through different Functions
 
-	std::vector<PatternCodeRegion*> PatternParents;
-	std::vector<PatternCodeRegion*> PatternChildren;
+	EdgeSet<PatternCodeRegion> PatternParents;
+	EdgeSet<PatternCodeRegion> PatternChildren;
 
-	std::vector<PatternGraphNode*> Children;
-	std::vector<PatternGraphNode*> Parents;
+	EdgeSet<PatternGraphNode> Children;
+	EdgeSet<PatternGraphNode> Parents;
 
 	std::vector<CallTreeNode*> CorrespondingCallTreeNodes;
 };
 
 
 
+/**
+ * The PatternGraph holds the functions, patterns, occurrences and code regions of one analysis.
+ * It is owned by the AnalysisContext of the analysis.
+ */
 class PatternGraph
 {
 public:
+	PatternGraph();
+
 	/**
 	 * @brief Selects and returns the root node for a tree representation.
 	 *
@@ -258,8 +312,34 @@ public:
 	 **/
 	FunctionNode* GetFunctionNode(clang::FunctionDecl* Decl);
 
+	/**
+	 * @brief Returns the function node of the declaration and registers the function if it is new.
+	 * In contrast to calling PatternGraph::GetFunctionNode() and PatternGraph::RegisterFunction(), the declaration is only hashed once.
+	 *
+	 * @param Decl The clang function declaration object.
+	 *
+	 * @return The function node, never NULL.
+	 **/
+	FunctionNode* GetOrRegisterFunction(clang::FunctionDecl* Decl);
+
 	FunctionNode* GetFunctionNode(std::string Name);
 
+	/**
+	 * @brief Registers the methods overridden by a virtual method in the class hierarchy index.
+	 * The chain of overridden methods is registered up to the base class that declares the method first,
+	 * so the index is complete even if the intermediate methods are not defined in an analysed file.
+	 *
+	 * @param Method A virtual method.
+	 **/
+	void RegisterOverrides(const clang::CXXMethodDecl* Method);
+
+	/**
+	 * @brief Returns the class hierarchy index of all analysed translation units, see PatternGraph::RegisterOverrides().
+	 *
+	 * @return The index of the overriding methods.
+	 **/
+	const OverriderIndex& GetOverriderIndex() { return Overriders; }
+
 	void RegisterOnlyPatternRootNode(PatternCodeRegion* CodeReg);
 
 	/**
@@ -270,18 +350,44 @@ public:
 	std::vector<FunctionNode*> GetAllFunctions() { return Functions; }
 
 	/**
-	 * @brief Get the instance of the PatternGraph
+	 * @brief Returns the arena that owns all nodes created during the analysis.
 	 *
-	 * @return PatternGraph instance
+	 * @return The arena of this analysis.
 	 **/
-	static PatternGraph* GetInstance()
-	{
-		static PatternGraph Graph;
-		return &Graph;
-	}
+	AnalysisArena& GetArena() { return Arena; }
+
+	/**
+	 * @brief Returns the table of all source files that contain nodes of the analysis.
+	 *
+	 * @return The file table of this analysis.
+	 **/
+	SourceFileTable& GetFileTable() { return FileTable; }
+
+	/**
+	 * @brief Takes an immutable snapshot of the graph for the statistics and similarity measures.
+	 * Has to be called after the graph is fully constructed; a previous snapshot is replaced.
+	 **/
+	void Freeze();
+
+	/**
+	 * @brief Returns the snapshot taken by the last call of PatternGraph::Freeze().
+	 *
+	 * @return The snapshot or NULL if the graph has not been frozen.
+	 **/
+	const PatternGraphSnapshot* GetSnapshot() { return Snapshot.get(); }
+
+	/**
+	 * @brief Forgets all registered nodes and releases the memory of all nodes in one bulk operation.
+	 * The CallTree of the analysis refers to these nodes, see AnalysisContext::Clear().
+	 **/
+	void Clear();
 
 private:
 	std::vector<FunctionNode*> Functions;
+	/* Index of the functions by their hash value */
+	std::unordered_map<FunctionID, FunctionNode*> FunctionsByHash;
+	/* The overriders of the virtual methods, used to link virtual calls */
+	OverriderIndex Overriders;
 	/* Save patterns, patternoccurrences and functions for later requests and linear access. */
 	std::vector<HPCParallelPattern*> Patterns;
 	std::vector<PatternOccurrence*> PatternOccurrences;
@@ -291,8 +397,26 @@ private:
 	/* When using the OnlyPattern flag we can have multiple rootPatterns*/
 	std::vector<PatternGraphNode*> OnlyPatternRootNodes;
 
-	/* Prevent object creation */
-	PatternGraph();
+	/* Owns the memory of all nodes of the analysis */
+	AnalysisArena Arena;
+
+	/* Resolves the file IDs of the StableLocations */
+	SourceFileTable FileTable;
+
+	/* Read-only view of the graph, created by Freeze() */
+	std::unique_ptr<PatternGraphSnapshot> Snapshot;
+
+	friend class PatternGraphSnapshot;
+
+	friend class PatternGraphFile;
+
+	/**
+	 * @brief Calculates the FunctionID that identifies a function across translation units.
+	 * It is derived from the USR of the declaration. If clang cannot generate a USR, the qualified name and the ODR hash are used instead.
+	 **/
+	static FunctionID CalculateFunctionID(const clang::FunctionDecl* Decl);
+
+	/* The graph owns its nodes, copies would release them twice */
 	PatternGraph(const PatternGraph&);
 	PatternGraph& operator = (const PatternGraph&);
 };
@@ -312,7 +436,6 @@ enum CallTreeNodeType{
 class Identification
 {
 public:
-	~Identification();
 	Identification();
 	/**
 		* Constructor for Identifications of CallTreeNodes which have a pattern as basis
@@ -321,7 +444,7 @@ public:
 	/**
 		* Constructor for Identifications of CallTreeNodes which have a function as basis
 	  **/
-	Identification(CallTreeNodeType type, unsigned identification);
+	Identification(CallTreeNodeType type, FunctionID identification);
 	/**
 		* Helps to compare the different Call TreeNodes without having to make
 		* a distinction between the different types of the nodes.
@@ -337,7 +460,7 @@ public:
 		* then the nodes are having the same pattern or function as basis
 		* (overloaded function)
 		**/
-	bool compare(unsigned Hash);
+	bool compare(FunctionID Hash);
 	/**
 		* Helps to compare the different Call TreeNodes without having to make
 		* a distinction between the different types of the nodes.
@@ -351,13 +474,13 @@ public:
 		**/
 	std::string  getIdentificationString() const {return IdentificationString;};
 	/**
-		* returns the IdentificationUnsigned which is equivalent to the hash value of a Function
+		* returns the IdentificationHash which is equivalent to the FunctionID of a Function
 		**/
-	unsigned getIdentificationUnsigned() const {return IdentificationUnsigned;};
+	FunctionID getIdentificationHash() const {return IdentificationHash;};
 
 private:
 	std::string IdentificationString = "";
-	unsigned IdentificationUnsigned = 0;
+	FunctionID IdentificationHash = 0;
 };
 
 /**
@@ -385,9 +508,9 @@ public:
 		**/
 	~CallTree();
 	/**
-		* Constructor of a CallTree
+		* Constructor of a CallTree. The nodes of the tree are created in the arena of the graph.
 		**/
-	CallTree();
+	explicit CallTree(PatternGraph* Graph);
 	/**
 		* Registers a CallTreeNode with the correct relation to the Caller. For Nodes which have
 		* a PatternCodeRegion(Pattern) as basis
@@ -409,6 +532,20 @@ public:
 		* if the code is instrumented correctly. This is usually the main function.
 		**/
 	void setRootNode(CallTreeNode* root);
+	/**
+		* Registers a CallTreeNode of the type Function for a call of FuncNode, see registerNode.
+		* If MergeCallSites is set and the surrounding function or code region already calls the same function, no node is created.
+		* Instead the call is added to the existing node, which counts the calls and keeps their lines.
+		**/
+	CallTreeNode* registerCall(FunctionNode* FuncNode, bool VirtualCall, int Line, bool MergeCallSites, CallTreeNodeType LastVisited, PatternCodeRegion* TopOfStack, FunctionNode* surroundingFunc);
+	/**
+		* Adds another call site to a node of the type Function, the multiplicity of the node is increased.
+		**/
+	void addCallSite(CallTreeNode* Node, int Line);
+	/**
+		* returns the lines of all calls merged into Node, beginning with the line of the node itself.
+		**/
+	std::vector<int> getCallSiteLines(CallTreeNode* Node);
 	/**
 		*Overloaded function. Registers the Caller as caller of Node in the CallTree.
 		**/
@@ -431,31 +568,42 @@ public:
 	void insertNodeIntoDeclVector(CallTreeNode* Node);
 	/**
 		*During the traversation we are not able to tell which CallTreeNode is called by another node. That is because the traversation of the code is not in call order. This function ensures the right relation of the different CallTreeNode and is called after the traversation of the code.
+		*Every node reachable from Root is visited once, see CallTreeLinker. The first call that reaches a declaration becomes its caller.
 		**/
-	void appendAllDeclToCallTree(CallTreeNode* Root, int maxdepth);
+	void appendAllDeclToCallTree(CallTreeNode* Root);
+	/**
+		* returns the summaries of the shared subtrees of the linked tree. They are only valid after setUpTree.
+		**/
+	CallTreeSummaries& GetSummaries(){return Summaries;};
 	/**
 		*@brief  Only after calling appendAllDeclToCallTree it is possible to see if the Pattern_Begin have the correct Children. Highly likely they have too much children.
-		In this function we trace back the path to from a CallTreeNode corresponding to a Pattern_End to the fitting CallTreeNode which corresponds to a Pattern_Begin.
+		In this function every CallTreeNode corresponding to a Pattern_End is matched to the fitting CallTreeNode which corresponds to a Pattern_Begin, in one traversal of the tree, see PatternNestingMatcher.
 		All children of the CallTreeNode corresponding to the Pattern_Begin after the children through we reached the CallTreeNode  are deleted as children from this CallTreeNode and assigned to its Caller.
+		Throws a TooManyBeginsException if a Pattern_Begin has no Pattern_End and terminates early if a Pattern_End has no Pattern_Begin.
 		**/
 	void setUpTree();
-	/**
-		* Finds a CallTreeNode corresponding to a Pattern_Begin for another CallTreeNode corresponding to a Pattern_End. If EndNode does not respond to a Pattern_End it returns NULL.
-		**/
-	CallTreeNode* findCorrespBegin(CallTreeNode* EndNode);
 	/**
 		* returns a pointer at the Vector which contains all the CallTreeNodes corresponding eather to a Pattern_Begin or a function declaration.
 		**/
 	std::vector<CallTreeNode*>* GetDeclarationVector();
 	/**
-		* Throws errors if the nesting of the pattern is incorrect.
+		* returns a pointer at the Vector which contains all the CallTreeNodes corresponding to a Pattern_End.
 		**/
-	bool lookIfTreeIsCorrect();
+	std::vector<CallTreeNode*>* GetPatternEndVector(){return &Pattern_EndVector;};
 	/**
 		* returns the root of the CallTree.
 		**/
 	CallTreeNode* getRoot(){return RootNode;};
+	/**
+		* Forgets all CallTreeNodes. The nodes themselves are owned by the AnalysisArena.
+		**/
+	void Clear();
+	/**
+		* returns the PatternGraph whose nodes this tree refers to.
+		**/
+	PatternGraph* GetGraph(){return Graph;};
 private:
+	PatternGraph* Graph;
 	//we store the Pattern in a Vector so we can go up to the parents
 	std::vector<CallTreeNode*> Pattern_EndVector;
 	// the RootNode is the main function, which is probably named differently
@@ -464,6 +612,35 @@ private:
 		*This vector stores all CallTreeNodes which are corresponding to a function declaration or a Pattern_Begin
 		**/
 	std::vector<CallTreeNode*> DeclarationVector;
+	/**
+		*Returns the node a call is appended to, i.e. the declaration of the surrounding function or the Pattern_Begin of the surrounding region. NULL if it is unknown.
+		*The declarations are looked up by their identification instead of scanning the DeclarationVector.
+		**/
+	CallTreeNode* findCallContainer(CallTreeNodeType LastVisited, PatternCodeRegion* TopOfStack, FunctionNode* surroundingFunc);
+	/**
+		*The function declarations of the DeclarationVector by their FunctionID, see findCallContainer.
+		**/
+	llvm::DenseMap<FunctionID, CallTreeNode*> DeclarationsByID;
+	/**
+		*The Pattern_Begin nodes of the DeclarationVector by the identifier of their code region, see findCallContainer.
+		**/
+	llvm::StringMap<CallTreeNode*> PatternBeginsByID;
+	/**
+		*The number of leading entries of the DeclarationVector that are in DeclarationsByID or PatternBeginsByID.
+		**/
+	size_t NumIndexedDeclarations = 0;
+	/**
+		*The merged calls of each container by the called function, see registerCall.
+		**/
+	llvm::DenseMap<std::pair<CallTreeNode*, FunctionID>, CallTreeNode*> MergedCalls;
+	/**
+		*The lines of the further calls merged into a node.
+		**/
+	llvm::DenseMap<CallTreeNode*, std::vector<int>> MergedCallSiteLines;
+	/**
+		*The cached summaries of the subtrees of the declarations.
+		**/
+	CallTreeSummaries Summaries;
 };
 
 /**
@@ -475,51 +652,43 @@ class CallTreeNode
 {
 public:
 	/**
-		*Destructor.
+		*Constructor of a CallTreeNode eather corresponding to a Pattern_End or a Pattern_Begin. The node is registered in Tree.
 		**/
-	~CallTreeNode();
+	CallTreeNode(CallTree* Tree, CallTreeNodeType type,  PatternCodeRegion* CorrespondingPat);
 	/**
-		*Constructor of a CallTreeNode eather corresponding to a Pattern_End or a Pattern_Begin.
+		* Constructor of a CallTreeNode eather corresponding to a function call or a function declaration. The node is registered in Tree.
 		**/
-	CallTreeNode(CallTreeNodeType type,  PatternCodeRegion* CorrespondingPat);
+	CallTreeNode(CallTree* Tree, CallTreeNodeType type, FunctionNode* CorrespondingFunction);
 	/**
-		* Constructor of a CallTreeNode eather corresponding to a function call or a function declaration.
+		* Constructor of a CallTreeNode eather corresponding to a Pattern_End or a Pattern_Begin. When the specific PatternCodeRegion is not known during the generation of the CallTreeNode.
 		**/
-	CallTreeNode(CallTreeNodeType type, FunctionNode* CorrespondingFunction);
+	CallTreeNode(CallTree* Tree, CallTreeNodeType type, std::string identification);
 	/**
-		* Constructor of a CallTreeNode eather corresponding to a Pattern_End or a Pattern_Begin. When the specific PatternCodeRegion is not known during the generation of the CallTreeNode.
+		* Constructor of a CallTreeNode with an existing Identification. In contrast to the other constructors, the node is neither registered
+		* in the CallTree nor with a corresponding node. This is used to restore a saved CallTree.
 		**/
-	CallTreeNode(CallTreeNodeType type, std::string identification);
+	CallTreeNode(CallTreeNodeType type, Identification* ident);
 
 
-	/**
-	 * The entry point for the call tree visitor.
-	 * The visitor is applied to this node and all its child nodes.
-	 *
-	 * @param Visitor an instance of the call tree visitor.
-	 * @since Sept. 10th 2020
-	 * @author Patrick Ziegler
-	 */
-	void Accept(CallTreeVisitor* Visitor);
 	/**
 		* Returns the Identification of a CallTreeNode
 		**/
 	Identification* GetID();
 	/**
-		* Returns a pointer of the Callee std::map.
+		* Returns a pointer of the ordered list of Callees.
 		**/
-	std::map<double, CallTreeNode*>* GetCallees();
+	CalleeList* GetCallees();
 	/**
 		* Returns a pointer of the CallTreeNode Caller.
 		**/
 	CallTreeNode* GetCaller();
 	/**
-		* Inserts a CallTreeNode into the Callee std::map.
+		* Appends a CallTreeNode to the list of Callees, unless it already is a Callee.
 		**/
-	void insertCallee(CallTreeNode* Node,double key = 0.0);
+	void insertCallee(CallTreeNode* Node);
 	/**
-		* Proofes if a CallTreeNode Callee is already in the Callee std::map.
-		* returns 1 if Callee is already stored in the Callee std::map otherwise 0.
+		* Proofes in constant time if a CallTreeNode Callee is already in the list of Callees.
+		* returns 1 if Callee is already stored in the list of Callees otherwise 0.
 		**/
 	bool isAlreadyCallee(CallTreeNode* Callee);
 	/**
@@ -533,7 +702,7 @@ public:
 	/**
 		* returns 1 if the node has the same underlying function/pattern otherwise 0
 		**/
-	bool compare(unsigned Hash);
+	bool compare(FunctionID Hash);
 	/**
 		* returns 1 if the node has the same underlying function/pattern otherwise 0
 		**/
@@ -546,8 +715,9 @@ public:
 		* For pattern it prints the ID (hashValue/String), the pattern name, the DesignSpace and END if the CallTreeNode corresponds to an Pattern_End.
 		* For function ist prints the name of the function and a HashValue.
 		* For CallTreeNodes from wich we dont, know the corresponding pattern or function it prints out the Identification which is always declared.
+		* The label is printed at the end of the line, e.g. the number of the subtree in a compact tree.
 		**/
-	void print();
+	void print(const std::string& Label = "");
 	/**
 		* Returns the NodeType of this.
 		**/
@@ -560,6 +730,22 @@ public:
 		* Returns the int lineNumber of this.
 		**/
 	int getLineNumber(){return lineNumber;};
+	/**
+		* Marks a CallTreeNode of the type Function as a virtual call. It is linked to the declarations of all overriders of the called method.
+		**/
+	void SetVirtualCall(bool Virtual){VirtualCall = Virtual;};
+	/**
+		* Returns true if this is a virtual call.
+		**/
+	bool IsVirtualCall(){return VirtualCall;};
+	/**
+		* Returns the number of calls represented by this node, see CallTree::registerCall. It is 1 unless calls were merged.
+		**/
+	unsigned GetMultiplicity(){return Multiplicity;};
+	/**
+		* Increases the number of calls represented by this node by one.
+		**/
+	void IncreaseMultiplicity(){Multiplicity++;};
 	/**
 		* Sets the GraphNode CorrespondingNode to Node. This declares wo which GraphNode (PatternCodeRegion of FunctionNode) <b>this</b> belongs.
 		**/
@@ -586,22 +772,13 @@ public:
 		**/
 	CallTreeNode* getCorrespCallTreeNodeRelation(){return correspPatCallNode;}
 	/**
-		* This function stores amount of lines between this and EndNode. Child has to be a direct Child of this and EndNode has to be already within the std::map LocTillEnds of Child.
-		* If the Child is a Function_Decl the belonging entry (the entry of EndNode) is only copied in the std::map LocTillEnds of this.
+		* Sets the number of lines between this Pattern_Begin and its Pattern_End.
 		**/
-	void setLOCTillPatternEnd(CallTreeNode* Child,  CallTreeNode* EndNode);
+	void setLOCTillPatternEnd(int Loc){locTillPatternEnd = Loc;};
 	/**
 		* This stores the number of lines between a Patten_End and a Pattern_Begin. But it should be only read  in the CallTreeNode corresponding to the Pattern_Begin.
 		**/
 	int* getLOCTillPatternEnd(){return &locTillPatternEnd;};
-	/**
-		* Returns the std::map LocTillEnds which at the end of the traversation should contain all lines of code to all Pattern_Ends which surround  this CallTreeNode. (All the patterns in which are a parent of this CallTreeNode.)
-		**/
-	std::map<CallTreeNode*, int>* getMapLOCToPatternEnds(){return &LocTillEnds;};
-	/**
-		* Inserts a Node (key) and a number in LocTillEnds.
-		**/
-	void insertLOCToPatternEnd(CallTreeNode* Node, int Loc);
 	/**
 		* sets the is suited bool from the corresponding Pattern to zero
 		**/
@@ -622,21 +799,14 @@ public:
 		**/
 	PatternGraphNode* CorrespondingNode = NULL;
 	/**
-		* This is an std::map which holds all Callees at the end of the traversation.
-		**/
-	std::map<double, CallTreeNode*> Callees;
-	/**
-		*	This is used to define the order of the children of a CallTreeNode. A child which appears earlier in the analyzed sourcecode has a lower int value in LocTillEns.
+		* This holds all Callees at the end of the traversation. A child which appears earlier in the analyzed sourcecode comes first.
 		**/
-	int actNumOfChild = 0;
+	CalleeList Callees;
 	/**
 		* This holds the Lines of Code between a PattenBegin to the CorespondingPatternEnd. Only redable from the CallTreeNode corresponding to the Pattern_Begin.
+		* It is the only LOC value stored per node, see PatternNestingMatcher.
 		**/
 	int locTillPatternEnd = 0;
-	/**
-		* After the traversation this should store the distance in lines of Code, of all enclosing Pattern, between a CallTreeNode coresponding to a Pattern_End and this.
-		**/
-	std::map<CallTreeNode*, int> LocTillEnds;
 	/**
 		* Stores the type of this CallTreeNode. Can range between Root, Function_Decl, Function, Pattern_Begin and Pattern_End
 		**/
@@ -645,11 +815,17 @@ public:
 		* stores the line Number in the analyzed sourcecode belonging to this CallTreeNode.
 		**/
 	int lineNumber;
+	/**
+		* True if the call is dispatched at runtime.
+		**/
+	bool VirtualCall = false;
+	/**
+		* The number of calls merged into this node.
+		**/
+	unsigned Multiplicity = 1;
 	/**
 		* Stores the corresponding Pattern_Begin/Pattern_End to a Pattern_End/Pattern_Begin.
 		**/
 	CallTreeNode* correspPatCallNode = NULL;
 };
 
-//
-extern CallTree* ClTre;
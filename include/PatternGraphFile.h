@@ -0,0 +1,38 @@
+#pragma once
+
+#include <string>
+
+class AnalysisContext;
+
+/**
+ * Saves the analysed pattern graph and the linked call tree to a binary file and loads them again.
+ * This makes it possible to rerun the statistics, the similarity measures and the tree output without running clang.
+ *
+ * The file consists of a header followed by sections of fixed-size records. Nodes reference each other by their index
+ * in the respective section and all strings are stored in one string table. Loading maps the file into memory and
+ * reads the records directly from the mapping, without parsing or copying the sections. The nodes themselves are
+ * created in the arenas of the analysis in a single pass over the sections, so the mapping is released afterwards.
+ * The file is written in the byte order of the host and is only meant to be read by the same build of the tool.
+ */
+class PatternGraphFile
+{
+public:
+	/**
+	 * @brief Writes the PatternGraph of the analysis, including the pattern metrics collected by the second clang run, and the CallTree to a file.
+	 *
+	 * Throws a GraphFileException if the file cannot be written.
+	 *
+	 * @param Analysis The analysis that is saved.
+	 * @param FileName The path of the file.
+	 **/
+	static void Save(AnalysisContext& Analysis, const std::string& FileName);
+
+	/**
+	 * @brief Restores a graph written by PatternGraphFile::Save() into the empty PatternGraph and CallTree of the analysis.
+	 * Throws a GraphFileException if the file cannot be read or is not a valid graph file.
+	 *
+	 * @param Analysis The analysis the graph is loaded into.
+	 * @param FileName The path of the file.
+	 **/
+	static void Load(AnalysisContext& Analysis, const std::string& FileName);
+};
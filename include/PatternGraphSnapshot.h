@@ -0,0 +1,174 @@
+#pragma once
+
+#include "llvm/ADT/ArrayRef.h"
+
+#include <vector>
+#include <cstddef>
+
+/* Forward declarations */
+class PatternGraph;
+class PatternGraphNode;
+class PatternCodeRegion;
+class HPCParallelPattern;
+
+/**
+ * An immutable, index-based copy of the structure of the pattern graph.
+ * It is created by PatternGraph::Freeze() once all sources have been analysed and is used by the statistics
+ * and the similarity measures, which only read the graph.
+ * Every FunctionNode and PatternCodeRegion is given a dense index; the functions come first, followed by the code regions.
+ * The edges are stored in compressed sparse row form: all targets lie in one contiguous array and each node
+ * owns the slice between two consecutive offsets. Per-node attributes are kept in parallel arrays.
+ * The snapshot is not updated when the graph is modified afterwards.
+ */
+class PatternGraphSnapshot
+{
+public:
+	typedef unsigned NodeIndex;
+
+	/**
+	 * The index of nodes that are not part of the snapshot.
+	 */
+	static const NodeIndex InvalidIndex = ~0u;
+
+	/**
+	 * @brief Builds the snapshot of the given graph and assigns the snapshot index to every node.
+	 *
+	 * @param Graph The graph after all nodes and edges have been registered.
+	 **/
+	explicit PatternGraphSnapshot(PatternGraph* Graph);
+
+	size_t GetNumNodes() const { return Nodes.size(); }
+
+	size_t GetNumFunctions() const { return NumFunctions; }
+
+	size_t GetNumCodeRegions() const { return Nodes.size() - NumFunctions; }
+
+	size_t GetNumPatterns() const { return Patterns.size(); }
+
+	bool IsCodeRegion(NodeIndex Node) const { return Node >= NumFunctions; }
+
+	PatternGraphNode* GetNode(NodeIndex Node) const { return Nodes[Node]; }
+
+	/**
+	 * @brief Returns the code region with the given index.
+	 *
+	 * @param Node The index of a code region, see PatternGraphSnapshot::IsCodeRegion().
+	 *
+	 * @return The code region.
+	 **/
+	PatternCodeRegion* GetCodeRegion(NodeIndex Node) const;
+
+	/**
+	 * @brief Checks whether the node was part of the graph when the snapshot was taken.
+	 *
+	 * @param Node An arbitrary node.
+	 *
+	 * @return True if the node has an index in this snapshot.
+	 **/
+	bool Contains(PatternGraphNode* Node) const;
+
+	/**
+	 * @brief The index of the designated root node of the graph.
+	 *
+	 * @return The index or InvalidIndex if the graph has no root node.
+	 **/
+	NodeIndex GetRootNode() const { return RootNode; }
+
+	llvm::ArrayRef<NodeIndex> GetChildren(NodeIndex Node) const { return Children.Get(Node); }
+
+	llvm::ArrayRef<NodeIndex> GetParents(NodeIndex Node) const { return Parents.Get(Node); }
+
+	/**
+	 * @brief The direct pattern children of a code region. Function nodes have no entries.
+	 **/
+	llvm::ArrayRef<NodeIndex> GetOnlyPatternChildren(NodeIndex Node) const { return OnlyPatternChildren.Get(Node); }
+
+	/**
+	 * @brief The direct pattern parents of a code region. Function nodes have no entries.
+	 **/
+	llvm::ArrayRef<NodeIndex> GetOnlyPatternParents(NodeIndex Node) const { return OnlyPatternParents.Get(Node); }
+
+	HPCParallelPattern* GetPattern(unsigned PatternIndex) const { return Patterns[PatternIndex]; }
+
+	/**
+	 * @brief All code regions of a pattern, in the order of HPCParallelPattern::GetCodeRegions().
+	 **/
+	llvm::ArrayRef<NodeIndex> GetCodeRegionsOfPattern(unsigned PatternIndex) const { return RegionsOfPattern.Get(PatternIndex); }
+
+	/**
+	 * @brief The index of the pattern a code region belongs to.
+	 *
+	 * @return The pattern index or InvalidIndex for function nodes.
+	 **/
+	unsigned GetPatternIndex(NodeIndex Node) const { return PatternOfNode[Node]; }
+
+	int GetLinesOfCode(NodeIndex Node) const { return LinesOfCode[Node]; }
+
+	bool IsSuitedForNestingStatistics(NodeIndex Node) const { return SuitedForNesting[Node] != 0; }
+
+	/**
+	 * @brief The connected component of the node. The components are numbered in the order of their first code region.
+	 *
+	 * @return The component ID or -1 if the node is not connected to any code region.
+	 **/
+	int GetConnectedComponent(NodeIndex Node) const { return ConnectedComponent[Node]; }
+
+	/**
+	 * @brief The number of connected components that contain at least one code region.
+	 **/
+	int GetNumConnectedComponents() const { return NumConnectedComponents; }
+
+private:
+	/**
+	 * One kind of edge in compressed sparse row form.
+	 * The targets of row i are Targets[Offsets[i]] to Targets[Offsets[i + 1] - 1].
+	 */
+	struct Adjacency
+	{
+		std::vector<unsigned> Offsets;
+
+		std::vector<NodeIndex> Targets;
+
+		llvm::ArrayRef<NodeIndex> Get(unsigned Row) const
+		{
+			return llvm::ArrayRef<NodeIndex>(Targets.data() + Offsets[Row], Offsets[Row + 1] - Offsets[Row]);
+		}
+	};
+
+	/**
+	 * @brief Appends the row of the next node, skipping targets that are not part of the snapshot.
+	 **/
+	template<typename NodeType>
+	void AppendRow(Adjacency& Edges, const std::vector<NodeType*>& Targets);
+
+	void MarkConnectedComponents();
+
+	std::vector<PatternGraphNode*> Nodes;
+
+	size_t NumFunctions = 0;
+
+	NodeIndex RootNode = InvalidIndex;
+
+	Adjacency Children;
+
+	Adjacency Parents;
+
+	Adjacency OnlyPatternChildren;
+
+	Adjacency OnlyPatternParents;
+
+	std::vector<HPCParallelPattern*> Patterns;
+
+	Adjacency RegionsOfPattern;
+
+	/* Dense node attributes, indexed by NodeIndex */
+	std::vector<unsigned> PatternOfNode;
+
+	std::vector<int> LinesOfCode;
+
+	std::vector<char> SuitedForNesting;
+
+	std::vector<int> ConnectedComponent;
+
+	int NumConnectedComponents = 0;
+};
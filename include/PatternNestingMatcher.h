@@ -0,0 +1,91 @@
+#pragma once
+
+#include "PatternGraph.h"
+
+#include "llvm/ADT/DenseSet.h"
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * Matches the Pattern_End nodes of a linked CallTree to their Pattern_Begin nodes.
+ *
+ * The tree spanned by the callers of the nodes is traversed once with an explicit stack. The Pattern_Begin
+ * nodes on the current path form a second stack, which is indexed by the pattern identifier, so the
+ * Pattern_Begin of a Pattern_End is found without walking back to it. The same sweep sets
+ * - the correspondence links of Pattern_Begin and Pattern_End,
+ * - the lines of code till the end of a pattern, as differences of the line offsets of the nodes on the path and
+ * - the nesting suitability of the patterns whose begin lies between a matched pair.
+ *
+ * This replaces the walk from every Pattern_End up to its Pattern_Begin, so the matching takes linear
+ * time in the size of the tree for correctly nested patterns.
+ */
+class PatternNestingMatcher
+{
+public:
+	explicit PatternNestingMatcher(CallTree* Tree);
+
+	/**
+	 * @brief Matches all Pattern_End nodes of the tree, beginning with the ones reachable from the root.
+	 * Pattern_End nodes in functions that are never called are matched from their outermost caller.
+	 *
+	 * @param Root The node the traversal starts with, usually the main function.
+	 *
+	 * @throws TooManyEndsException if a Pattern_End has no Pattern_Begin on its path.
+	 **/
+	void Match(CallTreeNode* Root);
+
+private:
+	/**
+	 * A node of the current path.
+	 */
+	struct Frame
+	{
+		CallTreeNode* Node;
+		size_t Next;
+		/* The lines of code from the start of the traversal to this node */
+		int Offset;
+	};
+
+	/**
+	 * @brief Traverses all nodes whose chain of callers leads to Top.
+	 **/
+	void Sweep(CallTreeNode* Top);
+
+	void Enter(CallTreeNode* Node, int Offset);
+
+	void Leave();
+
+	/**
+	 * @brief Matches a Pattern_End against the innermost open Pattern_Begin with the same identifier.
+	 * All Pattern_Begin nodes opened after that one are not suited for statistics which need a clear nesting.
+	 **/
+	void MatchEnd(CallTreeNode* EndNode, int Offset);
+
+	/**
+	 * @brief All callees of the Pattern_Begin after the child which leads to the Pattern_End are not really
+	 * children of the pattern. They are moved, in order, behind the Pattern_Begin into the callees of its caller.
+	 * The frames are adjusted, so the moved nodes are traversed next as callees of the caller.
+	 **/
+	void MoveCalleesBehindBegin(size_t BeginFrame);
+
+	/**
+	 * @brief The lines of code between a node and its caller. A function declaration is in the line of its call.
+	 **/
+	static int GetLineDistance(CallTreeNode* Node, CallTreeNode* Caller);
+
+	static void MarkNotSuited(CallTreeNode* BeginNode, CallTreeNode* EndNode);
+
+	CallTree* Tree;
+
+	llvm::DenseSet<CallTreeNode*> Visited;
+
+	std::vector<Frame> Frames;
+
+	/* The frame indices of the Pattern_Begin nodes on the current path */
+	std::vector<size_t> BeginStack;
+
+	/* The positions in BeginStack of the Pattern_Begin nodes on the current path, by identifier */
+	std::unordered_map<std::string, std::vector<size_t>> OpenBegins;
+};
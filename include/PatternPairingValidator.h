@@ -0,0 +1,99 @@
+#pragma once
+
+#include "SourceFileTable.h"
+
+#include "llvm/ADT/StringMap.h"
+
+#include <string>
+#include <vector>
+
+/* Forward declarations */
+class FunctionNode;
+class PatternCodeRegion;
+
+/**
+ * Validates the pairing of the Pattern_Begin and Pattern_End calls while the sources are traversed.
+ *
+ * Each instrumentation call is checked when it is visited, in the order in which the functions of the translation units
+ * are traversed, which is also the order the pattern stacks assume. A Pattern_End has to close a code region that is open,
+ * i.e. whose Pattern_Begin was visited before, in the same function or in a function traversed earlier.
+ * Errors are reported immediately with the file, the line and the function of the instrumentation call.
+ * Code regions that are still open after all translation units have been traversed are reported by Finish().
+ *
+ * Without the option to stop at the first error, the traversal continues, so all errors of the sources are reported at once.
+ * In both cases the analysis ends before the call tree is linked, instead of failing much later in CallTree::setUpTree().
+ */
+class PatternPairingValidator
+{
+public:
+	PatternPairingValidator(const SourceFileTable& Files, bool StopAtFirstError);
+
+	/**
+	 * @brief Opens a code region.
+	 *
+	 * @param CodeRegion The code region of the Pattern_Begin.
+	 * @param Loc The location of the Pattern_Begin.
+	 * @param Function The function that contains the Pattern_Begin.
+	 **/
+	void Begin(PatternCodeRegion* CodeRegion, StableLocation Loc, FunctionNode* Function);
+
+	/**
+	 * @brief Closes the open code region with the identifier or reports an error.
+	 *
+	 * @param ID The identifier of the Pattern_End.
+	 * @param Loc The location of the Pattern_End.
+	 * @param Function The function that contains the Pattern_End.
+	 *
+	 * @throw TerminateEarlyException if there is no open code region with this identifier and the analysis stops at the first error.
+	 *
+	 * @return The closed code region or NULL if there is no open code region with this identifier.
+	 **/
+	PatternCodeRegion* End(const std::string& ID, StableLocation Loc, FunctionNode* Function);
+
+	/**
+	 * @brief Reports the code regions that are never closed. Has to be called after all translation units have been traversed.
+	 *
+	 * @throw TerminateEarlyException if a code region is still open and the analysis stops at the first error.
+	 *
+	 * @return True if no error was found in the whole traversal.
+	 **/
+	bool Finish();
+
+	unsigned GetNumErrors() const { return this->NumErrors; }
+
+	/**
+	 * @brief Forgets all code regions and errors.
+	 **/
+	void Clear();
+
+private:
+	/**
+	 * A Pattern_Begin that was visited.
+	 */
+	struct BeginEntry
+	{
+		PatternCodeRegion* CodeRegion;
+		StableLocation Loc;
+		FunctionNode* Function;
+		bool Closed;
+	};
+
+	/**
+	 * @brief Prints the error with its source location.
+	 *
+	 * @throw TerminateEarlyException if the analysis stops at the first error.
+	 **/
+	void Report(StableLocation Loc, FunctionNode* Function, const std::string& Message);
+
+	const SourceFileTable& Files;
+
+	bool StopAtFirstError;
+
+	/* All Pattern_Begin calls in the order of the traversal */
+	std::vector<BeginEntry> Begins;
+
+	/* Maps the identifier of every code region to its entry in Begins */
+	llvm::StringMap<size_t> BeginIndices;
+
+	unsigned NumErrors = 0;
+};
@@ -0,0 +1,30 @@
+#pragma once
+
+#include "DesignSpaces.h"
+
+#include "llvm/ADT/StringRef.h"
+
+#include <string>
+
+/**
+ * The information of a pattern begin instrumentation call, given as "DesignSpace PatternName ID".
+ */
+struct PatternBeginString
+{
+	DesignSpace DesignSp;
+	std::string PatternName;
+	std::string PatternID;
+};
+
+/**
+ * @brief Splits the string argument of a pattern begin instrumentation call into its three tokens.
+ * A token consists of letters and digits, the tokens are separated by whitespace.
+ * Leading and trailing whitespace is ignored.
+ *
+ * @param Str The content of the string literal.
+ *
+ * @throw PatternStringException with the byte offset of the first invalid character if the string is malformed.
+ *
+ * @return The design space, pattern name and identifier.
+ **/
+PatternBeginString ParsePatternBeginString(llvm::StringRef Str);
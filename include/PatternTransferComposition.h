@@ -0,0 +1,82 @@
+#pragma once
+
+#include "PatternGraph.h"
+
+#include "llvm/ADT/DenseMap.h"
+
+#include <vector>
+
+/**
+ * Composes the pattern stack transfers of all functions to the cross-function nesting of the pattern code regions.
+ *
+ * The transfer of a function is recorded in the pattern graph while the code is traversed:
+ * the code regions it opens outside of other regions (FunctionNode::GetPatternChildren()) and its call sites,
+ * either within a code region or outside of all regions, i.e. as a child of the calling function.
+ * Every function is summarised once, after all translation units have been traversed. The pattern parents of
+ * a function are the regions around its call sites, composed with the pattern parents of the functions that
+ * call it outside of a region. The pattern children of a function become the only-pattern children of its pattern parents.
+ *
+ * The functions are processed in the topological order of the strongly connected components of the calls outside
+ * of regions, so the composition takes time linear in the number of call edges, even for deep or recursive call chains.
+ */
+class PatternTransferComposition
+{
+public:
+	explicit PatternTransferComposition(PatternGraph* Graph);
+
+	/**
+	 * @brief Sets the pattern parents of all functions and registers the pattern children of the functions
+	 * as only-pattern children of their pattern parents.
+	 **/
+	void Compose();
+
+private:
+	/**
+	 * The state of a function during Tarjan's algorithm.
+	 */
+	struct NodeState
+	{
+		int Index;
+		int LowLink;
+		bool OnStack;
+		/* The component of the function, -1 as long as it is not complete */
+		int Component;
+	};
+
+	/**
+	 * A function whose callees are being traversed.
+	 */
+	struct Frame
+	{
+		FunctionNode* Function;
+		size_t Next;
+	};
+
+	/**
+	 * @brief Collects the strongly connected components reachable from the function, callees first.
+	 **/
+	void Traverse(FunctionNode* Function);
+
+	void Enter(FunctionNode* Function);
+
+	void Leave();
+
+	/**
+	 * @brief Composes the transfers of the callers with the pattern parents of the members of a component.
+	 * The components of all callers outside of a region have to be composed already.
+	 **/
+	void ComposeComponent(int Component);
+
+	PatternGraph* Graph;
+
+	llvm::DenseMap<FunctionNode*, NodeState> States;
+
+	std::vector<Frame> Frames;
+
+	std::vector<FunctionNode*> ComponentStack;
+
+	/* The members of each component, in the order in which the components are completed */
+	std::vector<std::vector<FunctionNode*>> Components;
+
+	int NextIndex;
+};
@@ -27,6 +27,7 @@ enum SimilarityCriterion
 class SimilarityMeasure : public HPCPatternStatistic{
 	public:
 		SimilarityMeasure(
+				PatternGraph* myGraph,
 				PatternGraphNode* myRootNode,
 				GraphSearchDirection mySearchDirection,
 				SimilarityCriterion mySimilarityCriterion,
@@ -39,6 +40,11 @@ class SimilarityMeasure : public HPCPatternStatistic{
 		void Print() override;
 		void CSVExport(std::string FileName) override;
 
+		/**
+		 * Returns the number of similarity pairs calculated so far.
+		 */
+		size_t GetNumberOfSimilarityPairs() const { return Similarities.size(); }
+
 	protected:
 		/**
  		 * A vector containing all pattern sequences found in the pattern graph.
@@ -0,0 +1,155 @@
+#pragma once
+
+#include "clang/Basic/SourceLocation.h"
+#include "clang/Basic/SourceManager.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/StringMap.h"
+
+#include <string>
+#include <vector>
+
+/**
+ * A position in the analysed source code that stays meaningful after the clang::SourceManager that produced it is gone.
+ * It consists of a file ID from PInT's own SourceFileTable, the byte offset in the file and the line number.
+ * Locations in macro expansions are mapped to the position of the expansion.
+ */
+struct StableLocation
+{
+	/**
+	 * The file ID used for locations that could not be resolved to a file.
+	 */
+	static const unsigned InvalidFileID = 0;
+
+	unsigned FileID = InvalidFileID;
+
+	unsigned Offset = 0;
+
+	unsigned Line = 0;
+
+	StableLocation() {}
+
+	StableLocation(unsigned FileID, unsigned Offset, unsigned Line) : FileID(FileID), Offset(Offset), Line(Line) {}
+
+	bool IsValid() const { return FileID != InvalidFileID; }
+
+	bool operator == (const StableLocation& Other) const { return FileID == Other.FileID && Offset == Other.Offset; }
+
+	bool operator != (const StableLocation& Other) const { return !(*this == Other); }
+
+	/**
+	 * Orders locations by file first and by offset second.
+	 * Only locations within the same file are ordered in a meaningful way.
+	 */
+	bool operator < (const StableLocation& Other) const
+	{
+		return FileID < Other.FileID || (FileID == Other.FileID && Offset < Other.Offset);
+	}
+};
+
+/**
+ * A range of two stable locations in the same file. Both ends are included.
+ */
+struct StableRange
+{
+	StableLocation Begin;
+
+	StableLocation End;
+
+	StableRange() {}
+
+	StableRange(StableLocation Begin, StableLocation End) : Begin(Begin), End(End) {}
+
+	/**
+	 * @brief Checks if the location lies within this range.
+	 *
+	 * @param Loc An arbitrary location.
+	 *
+	 * @return True if Loc is in the same file and between Begin and End.
+	 **/
+	bool Contains(const StableLocation& Loc) const
+	{
+		return Loc.IsValid() && Loc.FileID == Begin.FileID && !(Loc < Begin) && !(End < Loc);
+	}
+};
+
+/**
+ * The SourceFileTable assigns every analysed source file a small ID, which is the same in all clang runs of one analysis.
+ * Files are identified by their path.
+ */
+class SourceFileTable
+{
+public:
+	SourceFileTable();
+
+	/**
+	 * @brief Returns the ID of the file, registering the file if it is new.
+	 *
+	 * @param FileName The path of the file.
+	 *
+	 * @return The ID of the file, never StableLocation::InvalidFileID.
+	 **/
+	unsigned GetFileID(llvm::StringRef FileName);
+
+	/**
+	 * @brief Returns the path of a registered file.
+	 *
+	 * @param FileID The ID of the file.
+	 *
+	 * @return The path of the file or an empty string for unknown IDs.
+	 **/
+	std::string GetFileName(unsigned FileID) const;
+
+	/**
+	 * @brief The number of IDs handed out so far, including StableLocation::InvalidFileID.
+	 **/
+	unsigned GetNumFileIDs() const { return FileNames.size(); }
+
+	/**
+	 * @brief Removes all files from the table.
+	 **/
+	void Clear();
+
+private:
+	llvm::StringMap<unsigned> FileIDs;
+
+	/* Indexed by file ID, the first entry belongs to the invalid ID */
+	std::vector<std::string> FileNames;
+};
+
+/**
+ * Translates the clang::SourceLocations of one translation unit to StableLocations.
+ * The file IDs of the SourceManager are cached, so the translation of each location is a hash lookup.
+ * An object of this class must not outlive the SourceManager it was created with.
+ */
+class StableLocationTranslator
+{
+public:
+	StableLocationTranslator(const clang::SourceManager& SourceMan, SourceFileTable& Files);
+
+	/**
+	 * @brief Translates a location of the current translation unit.
+	 *
+	 * @param Loc A location from the SourceManager of this translator.
+	 * @param WithLine Whether the line number is computed. Comparisons of locations only need the offset.
+	 *
+	 * @return The stable location. It is invalid if Loc is invalid or not part of a file.
+	 **/
+	StableLocation Translate(clang::SourceLocation Loc, bool WithLine = true);
+
+	/**
+	 * @brief Translates both ends of a range of the current translation unit.
+	 *
+	 * @param Range A range from the SourceManager of this translator.
+	 *
+	 * @return The stable range.
+	 **/
+	StableRange Translate(clang::SourceRange Range);
+
+private:
+	const clang::SourceManager& SourceMan;
+
+	SourceFileTable& Files;
+
+	/* Maps the clang file IDs of this translation unit to the IDs in the file table */
+	llvm::DenseMap<clang::FileID, unsigned> FileIDCache;
+};
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+/* Forward declarations */
+class HPCPatternStatistic;
+class PerPatternStatistic;
+
+/**
+ * Runs the calculations of the statistics of one analysis on a pool of threads.
+ *
+ * The statistics only read the frozen pattern graph, so they can be calculated concurrently. A task that changes state
+ * shared with other tasks, e.g. marks written to the nodes of the pattern graph, has to be declared
+ * as a dependency of the tasks that read this state. A task is started as soon as all of its dependencies have finished.
+ * A PerPatternStatistic is split into parts, each calculating a range of the patterns, so one expensive statistic is
+ * distributed over all threads as well. The results are the same as those of a serial run.
+ *
+ * With a single thread, the tasks run in the calling thread in the order in which they have been added.
+ */
+class StatisticScheduler
+{
+public:
+	typedef size_t TaskID;
+
+	/**
+	 * @param NumThreads The number of threads, 0 for one thread per hardware thread.
+	 **/
+	explicit StatisticScheduler(unsigned NumThreads);
+
+	/**
+	 * @brief Adds a task.
+	 *
+	 * @param Work The task.
+	 * @param Dependencies The tasks that have to finish before this task starts. Only tasks added before can be dependencies.
+	 *
+	 * @throw std::invalid_argument if a dependency is not a task added before.
+	 *
+	 * @return The ID of the task.
+	 **/
+	TaskID AddTask(std::function<void()> Work, const std::vector<TaskID>& Dependencies = {});
+
+	/**
+	 * @brief Adds a task that calculates the statistic.
+	 **/
+	TaskID AddStatistic(HPCPatternStatistic* Statistic, const std::vector<TaskID>& Dependencies = {});
+
+	/**
+	 * @brief Adds the tasks that calculate the statistic, the patterns are split into one part per thread.
+	 *
+	 * @return The ID of the task that finishes the statistic.
+	 **/
+	TaskID AddPerPatternStatistic(PerPatternStatistic* Statistic, const std::vector<TaskID>& Dependencies = {});
+
+	/**
+	 * @brief Runs all tasks and returns after all of them have finished.
+	 * After a task has thrown an exception, the tasks that have not started yet are skipped.
+	 *
+	 * @throw The first exception thrown by a task, after the running tasks have finished.
+	 **/
+	void Run();
+
+	unsigned GetNumThreads() const { return this->NumThreads; }
+
+private:
+	struct Task
+	{
+		std::function<void()> Work;
+		/* The tasks that depend on this task */
+		std::vector<TaskID> Dependents;
+		size_t NumDependencies;
+	};
+
+	/**
+	 * @brief Takes ready tasks until all tasks have finished, in each thread of the pool.
+	 **/
+	void Work();
+
+	/**
+	 * @brief Runs the task.
+	 *
+	 * @return The exception thrown by the task, if any.
+	 **/
+	std::exception_ptr RunTask(TaskID ID);
+
+	unsigned NumThreads;
+
+	std::vector<Task> Tasks;
+
+	/* The number of dependencies of each task that have not finished yet */
+	std::vector<size_t> OpenDependencies;
+
+	/* The tasks whose dependencies have all finished */
+	std::deque<TaskID> Ready;
+
+	size_t NumFinished;
+
+	std::exception_ptr FirstException;
+
+	std::mutex Mutex;
+
+	/* Signalled when a task becomes ready or the last task finishes */
+	std::condition_variable Changed;
+};
@@ -1,51 +1,61 @@
 #pragma once
 
 #include "HPCParallelPattern.h"
+#include <string>
 #ifndef PATTERNGRAPH_H
 	#include "PatternGraph.h"
 #endif
 
 /**
- * A class that implements (recursive) visualisation of the call tree.
+ * A class that implements the visualisation of the call tree.
+ * The trees are traversed with an explicit stack, so deep trees do not exhaust the call stack.
  */
 class CallTreeVisualisation
 {
 public:
 	/**
-		* Prints the relation Tree
+		* Prints the relation Tree.
+		* A compact tree prints the children of a node only once and refers back to them, e.g. "-> see #12", afterwards.
+		* If maxchildren is not 0, at most maxchildren children of a node are printed.
 		**/
-	static void PrintRelationTree(int maxdepth, bool onlyPattern);
+	static void PrintRelationTree(int maxdepth, PatternGraph* Graph, bool onlyPattern, bool compact, unsigned maxchildren);
 	/**
-		* Prints the CallTree
+		* Prints the CallTree, see PrintRelationTree for compact and maxchildren.
 		**/
-	static void PrintCallTree(int maxdepth, CallTree* CalTre, bool onlyPattern);
+	static void PrintCallTree(int maxdepth, CallTree* CalTre, bool onlyPattern, bool compact, unsigned maxchildren);
 
 private:
+	/**
+		* Prints the pattern graph below a node, see DepthFirstTraversal.
+		**/
+	class PatternGraphPrinter;
+	/**
+		* Prints the call tree below a node, see DepthFirstTraversal.
+		**/
+	class CallTreePrinter;
 	/**
 		* Prints the OnlyPatterntree and is called from PrintRelationTree.
 		**/
-	static void PrintOnlyPatternTree(int maxdepth);
+	static void PrintOnlyPatternTree(int maxdepth, PatternGraph* Graph, bool compact, unsigned maxchildren);
 	/**
 		* Prints a Pattern
 		**/
-	static void PrintPattern(PatternCodeRegion* PatternCodeRegion, int depth, int maxdepth);
+	static void PrintPattern(PatternCodeRegion* PatternCodeRegion, int depth, const std::string& Label);
 	/**
 		* Prints a Function
 		**/
-	static void PrintFunction(FunctionNode* FnCall, int depth, int maxdepth);
+	static void PrintFunction(FunctionNode* FnCall, int depth, const std::string& Label);
 	/**
-		* Prints recursevely the OnlyPatternTree
+		* Prints a indent in dependent on depth.
 		**/
-	static void PrintRecursiveOnlyPattern(PatternCodeRegion* CodeRegion,int depth,int maxdepth);
+	static void PrintIndent(int depth);
 	/**
-		* Prints recursevely the CallTree
+		* Returns the number of children that are printed if at most maxchildren are printed, 0 means no limit.
 		**/
- 	static void PrintCallTreeRecursively(int &HelpKey, std::vector<std::tuple<int, CallTreeNode*>> &CallTreeHelp, CallTreeNode* ClTrNode, int depth, int maxdepth, bool onlyPattern);
+	static size_t LimitChildren(size_t numchildren, unsigned maxchildren);
 	/**
-		* Prints a indent in dependent on depth.
+		* Prints how many children of a node are left out.
 		**/
-	static void PrintIndent(int depth);
-
-	static int searchDepthInCallTreeHelp(std::vector<std::tuple<int, CallTreeNode*>> &CallTreeHelp, CallTreeNode* EndNode);
+	static void PrintOmittedChildren(size_t numomitted, int depth);
 
 };
@@ -21,8 +21,9 @@ class ASTDelegatorConsumer : public clang::ASTConsumer{
 		 * and the AST nodes.
 		 *
 		 * @param myContext The context over the translation unit.
+		 * @param myAnalysis The analysis whose pattern graph is extended with the metrics.
 		 */
-		explicit ASTDelegatorConsumer(clang::ASTContext* myContext);
+		ASTDelegatorConsumer(clang::ASTContext* myContext, AnalysisContext* myAnalysis);
 		/**
 		 * Applies the visitors to the translation unit.
 		 * @param myContext The context over the translation unit
@@ -2,11 +2,19 @@
 
 #include "clang/Frontend/FrontendActions.h"
 
+class AnalysisContext;
+
 /**
  * This class is the hook point for the AST traversal.
  * @see ASTDelegatorConsumer
  */
 class ASTFrontendDelegatorAction : public clang::ASTFrontendAction {
+	public:
+		/**
+		 * @param myAnalysis The analysis the consumers work on.
+		 */
+		explicit ASTFrontendDelegatorAction(AnalysisContext* myAnalysis) : Analysis(myAnalysis){
+		}
 	protected:
 		/**
 		 * Creates the consumer for processing the nodes
@@ -18,4 +26,6 @@ class ASTFrontendDelegatorAction : public clang::ASTFrontendAction {
 				clang::CompilerInstance& myCompiler,
 				llvm::StringRef myFile
 		) override;
+	private:
+		AnalysisContext* Analysis;
 };
@@ -17,8 +17,9 @@ class ASTInstrumentationConsumer : public clang::ASTConsumer{
 		 * and those that ought to be ignored.
 		 *
 		 * @param myContext The context over the translation unit.
+		 * @param myAnalysis The analysis the patterns are registered in.
 		 */
-		explicit ASTInstrumentationConsumer(clang::ASTContext* myContext);
+		ASTInstrumentationConsumer(clang::ASTContext* myContext, AnalysisContext* myAnalysis);
 		/**
 		 * Applies the visitors to the translation unit.
 		 * @param myContext The context over the translation unit
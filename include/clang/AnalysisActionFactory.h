@@ -0,0 +1,31 @@
+#pragma once
+
+#include "clang/Tooling/Tooling.h"
+#include "llvm/Config/llvm-config.h"
+
+class AnalysisContext;
+
+/**
+ * Creates the frontend actions of one analysis.
+ * In contrast to clang::tooling::newFrontendActionFactory(), every action is handed the AnalysisContext,
+ * so the consumers do not need any global state.
+ * @tparam ActionType A frontend action with a constructor taking an AnalysisContext*.
+ */
+template <typename ActionType> class AnalysisActionFactory : public clang::tooling::FrontendActionFactory{
+	public:
+		explicit AnalysisActionFactory(AnalysisContext* myAnalysis) : Analysis(myAnalysis){
+		}
+
+#if LLVM_VERSION_MAJOR >= 10
+		std::unique_ptr<clang::FrontendAction> create() override{
+			return (std::unique_ptr<clang::FrontendAction>(new ActionType(Analysis)));
+		}
+#else
+		clang::FrontendAction* create() override{
+			return (new ActionType(Analysis));
+		}
+#endif
+
+	private:
+		AnalysisContext* Analysis;
+};
@@ -15,8 +15,13 @@
  * Loose Class cohesion.
  *
  */
-class CohesionStatistic : public HPCPatternStatistic{
+class CohesionStatistic : public PerPatternStatistic{
 	public:
+		/**
+		 * Creates the statistic for the provided pattern graph.
+		 * @param myGraph The pattern graph the statistic is calculated for.
+		 */
+		explicit CohesionStatistic(PatternGraph* myGraph);
 		/**
 		 * An empty destructor.
 		 */
@@ -24,7 +29,7 @@ class CohesionStatistic : public HPCPatternStatistic{
 		/**
 		 * Calculates the cohesion for every parallel pattern in the pattern graph.
 		 */
-		void Calculate() override;
+		using PerPatternStatistic::Calculate;
 		/**
 		 * Prints the number of directly and indirectly connected patterns, in addition
 		 * to the TCC and LCC for each parallel pattern.
@@ -65,6 +70,11 @@ class CohesionStatistic : public HPCPatternStatistic{
 			double LCC;
 		};
 
+		void PrepareResults(size_t NumPatterns) override;
+
+		void CalculatePattern(size_t Index, HPCParallelPattern* Pattern) override;
+
+		void StoreResult(size_t Index, HPCParallelPattern* Pattern) override;
 		/**
 		 * Derives the directly and indirectly connected patterns.
 		 * The detected patterns are stored in the return structure.
@@ -90,4 +100,8 @@ class CohesionStatistic : public HPCPatternStatistic{
 		 * Contains the cohesion for all patterns in the graph.
 		 */
 		std::map<HPCParallelPattern*, CohesionCounter> CohesionMap;
+		/**
+		 * The results of the patterns while they are calculated, in the order of the patterns.
+		 */
+		std::vector<CohesionCounter> Results;
 };
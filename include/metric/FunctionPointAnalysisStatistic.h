@@ -25,8 +25,13 @@
  * the end user, without altering the state of the program. However, in the context of the analysis,
  * those are omitted.
  */
-class FunctionPointAnalysisStatistic : public HPCPatternStatistic{
+class FunctionPointAnalysisStatistic : public PerPatternStatistic{
 	public:
+		/**
+		 * Creates the statistic for the provided pattern graph.
+		 * @param myGraph The pattern graph the statistic is calculated for.
+		 */
+		explicit FunctionPointAnalysisStatistic(PatternGraph* myGraph);
 		/**
 		 * An empty destructor.
 		 */
@@ -34,7 +39,7 @@ class FunctionPointAnalysisStatistic : public HPCPatternStatistic{
 		/**
 		 * Performs the function point analysis on every parallel pattern.
 		 */
-		void Calculate();
+		using PerPatternStatistic::Calculate;
 		/**
 		 * Prints the unadjusted function point count, the value adjustment factor
 		 * and the final function point count for each parallel pattern.
@@ -71,6 +76,11 @@ class FunctionPointAnalysisStatistic : public HPCPatternStatistic{
 			double FunctionPointCount;
 		};
 
+		void PrepareResults(size_t NumPatterns) override;
+
+		void CalculatePattern(size_t Index, HPCParallelPattern* Pattern) override;
+
+		void StoreResult(size_t Index, HPCParallelPattern* Pattern) override;
 		/**
 		 * Performs the function point analysis on the corresponding pattern.
 		 * @param Pattern The pattern associated with the function point analysis.
@@ -102,4 +112,8 @@ class FunctionPointAnalysisStatistic : public HPCPatternStatistic{
 		 * Contains the results of the function point analysis for all patterns in the graph.
 		 */
 		std::map<HPCParallelPattern*, FunctionPointCounter> FunctionPointMap;
+		/**
+		 * The results of the patterns while they are calculated, in the order of the patterns.
+		 */
+		std::vector<FunctionPointCounter> Results;
 };
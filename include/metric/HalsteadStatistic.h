@@ -11,8 +11,13 @@
  * include common symbols, like addition or multiplication, but also
  * language specific keywords.
  */
-class HalsteadStatistic : public HPCPatternStatistic{
+class HalsteadStatistic : public PerPatternStatistic{
 	public:
+		/**
+		 * Creates the statistic for the provided pattern graph.
+		 * @param myGraph The pattern graph the statistic is calculated for.
+		 */
+		explicit HalsteadStatistic(PatternGraph* myGraph);
 		/**
 		 * An empty destructor.
 		 */
@@ -20,7 +25,7 @@ class HalsteadStatistic : public HPCPatternStatistic{
 		/**
 		 * Calculates the halstead metrics for every parallel pattern in the pattern graph.
 		 */
-		void Calculate();
+		using PerPatternStatistic::Calculate;
 		/**
 		 * Prints the number of directly and indirectly connected patterns, in addition
 		 * to the values derived by the Halstead metric. Those consist of:
@@ -110,11 +115,17 @@ class HalsteadStatistic : public HPCPatternStatistic{
 			double NumberOfDeliveredBugs;
 		};
 
+		void PrepareResults(size_t NumPatterns) override;
+
+		void CalculatePattern(size_t Index, HPCParallelPattern* Pattern) override;
+
+		void StoreResult(size_t Index, HPCParallelPattern* Pattern) override;
 		/**
 		 * Calculates the Halstead metrics for the corresponding pattern.
 		 * @param Pattern The pattern associated with the Haldstead matrics.
+		 * @return The Halstead metrics of the pattern.
 		 */
-		void Calculate(HPCParallelPattern* Pattern);
+		HalsteadCounter Calculate(HPCParallelPattern* Pattern);
 		/**
 		 * Let \f$ \eta_1 \f$ be the number of distinct operators.<br>
 		 * Let \f$ \eta_2 \f$ be the number of distinct operands.<br>
@@ -184,4 +195,8 @@ class HalsteadStatistic : public HPCPatternStatistic{
 		 * Contains the Halstead metrics for all patterns.
 		 */
 		std::map<HPCParallelPattern*, HalsteadCounter> HalsteadMap;
+		/**
+		 * The results of the patterns while they are calculated, in the order of the patterns.
+		 */
+		std::vector<HalsteadCounter> Results;
 };
@@ -1,13 +1,13 @@
 #pragma once
 
-#include "visitor/PatternGraphNodeVisitor.h"
+#include "visitor/IterativePatternGraphNodeVisitor.h"
 #include <set>
 
 /**
  * The set of connected patterns consists of all patterns that are reachable
  * from a given node. It includes both directly and indirectly connected patterns.
  */
-class ConnectedPatternCounter : public PatternGraphNodeVisitor {
+class ConnectedPatternCounter : public IterativePatternGraphNodeVisitor<ConnectedPatternCounter> {
 	public:
 		/**
 		 * Contains all distinct patterns in the subtree.
@@ -18,5 +18,5 @@ class ConnectedPatternCounter : public PatternGraphNodeVisitor {
 		 * Includes the visited node to the connected patterns.
 		 * @param Node One of the nested patterns of the root node.
 		 */
-		void VisitParallelPattern(HPCParallelPattern* Node) override;
+		void VisitParallelPattern(HPCParallelPattern* Node);
 };
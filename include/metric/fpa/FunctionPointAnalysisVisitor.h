@@ -22,8 +22,9 @@ class FunctionPointAnalysisVisitor : public ClangPatternVisitor<FunctionPointAna
 		 *
 		 * @param myContext The context required when comparing two source locations.
 		 */
-		explicit FunctionPointAnalysisVisitor(
-				clang::ASTContext* myContext
+		FunctionPointAnalysisVisitor(
+				clang::ASTContext* myContext,
+				PatternGraph* myGraph
 		);
 
 		/**
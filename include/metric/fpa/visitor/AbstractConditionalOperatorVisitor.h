@@ -14,11 +14,13 @@ class AbstractConditionalOperatorVisitor : public DeclRefExprVisitor<AbstractCon
 		 * Creates a new visitor for conditional operators.
 		 *
 		 * @param myContext The context required when comparing two source locations.
+		 * @param myGraph The pattern graph owning the detected function points.
 		 * @param mySourceRange The range of the closest pattern code region.
 		 */
 		explicit AbstractConditionalOperatorVisitor(
 				clang::ASTContext* myContext,
-				clang::SourceRange mySourceRange
+				PatternGraph* myGraph,
+				StableRange mySourceRange
 		);
 		/**
 		 * Processes a conditional operator. If this is the first occurrence of the operator, it will be treated as
@@ -17,11 +17,13 @@ class AssignmentOperatorVisitor : public DeclRefExprVisitor<AssignmentOperatorVi
 		 * Creates a new visitor for assignment operators.
 		 *
 		 * @param myContext The context required when comparing two source locations.
+		 * @param myGraph The pattern graph owning the detected function points.
 		 * @param mySourceRange The range of the closest pattern code region.
 		 */
 		explicit AssignmentOperatorVisitor(
 				clang::ASTContext* myContext,
-				clang::SourceRange mySourceRange
+				PatternGraph* myGraph,
+				StableRange mySourceRange
 		);
 		/**
 		 * Processes a binary operator if it is an (compound) assignment. Clang doesn't allow for a more detailed
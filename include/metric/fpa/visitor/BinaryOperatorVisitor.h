@@ -14,11 +14,13 @@ class BinaryOperatorVisitor : public DeclRefExprVisitor<BinaryOperatorVisitor>{
 		 * Creates a new visitor for binary operators.
 		 *
 		 * @param myContext The context required when comparing two source locations.
+		 * @param myGraph The pattern graph owning the detected function points.
 		 * @param mySourceRange The range of the closest pattern code region.
 		 */
 		explicit BinaryOperatorVisitor(
 				clang::ASTContext* myContext,
-				clang::SourceRange mySourceRange
+				PatternGraph* myGraph,
+				StableRange mySourceRange
 		);
 		/**
 		 * Processes a binary operator. If this is the first occurrence of the operator, it will be treated as
@@ -7,6 +7,7 @@
 #include "metric/fpa/InternalLogicalFile.h"
 #include "metric/fpa/ExternalInterfaceFile.h"
 #include "metric/fpa/ExternalOutput.h"
+#include "PatternGraph.h"
 
 /**
  * Extracts the data functions in an expression. If a variable has been declared outside
@@ -20,13 +21,15 @@ template <typename Derived> class DeclRefExprVisitor : public FunctionPointVisit
 		 * Creates a new instance of the visitor.
 		 *
 		 * @param myContext The context required when comparing two source locations.
+		 * @param myGraph The pattern graph owning the detected function points.
 		 * @param mySourceRange The range of the closest pattern code region.
 		 */
 		explicit DeclRefExprVisitor(
 				clang::ASTContext* myContext,
-				clang::SourceRange mySourceRange
+				PatternGraph* myGraph,
+				StableRange mySourceRange
 		) :
-			FunctionPointVisitor<Derived>(myContext, mySourceRange){
+			FunctionPointVisitor<Derived>(myContext, myGraph, mySourceRange){
 		}
 
 		/**
@@ -51,7 +54,7 @@ template <typename Derived> class DeclRefExprVisitor : public FunctionPointVisit
 			Visitor.TraverseDecl(Node);
 
 			if(FunctionPointVisitor<Derived>::OverlapsWithEnvironment(Node)){
-				FunctionPoint* FunctionPoint = new ExternalOutput(
+				FunctionPoint* FunctionPoint = this -> Graph -> GetArena().template Create<ExternalOutput>(
 						Visitor.det,
 						Visitor.ftr,
 						PrettyPrinter::PrintPretty(Node)
@@ -74,7 +77,7 @@ template <typename Derived> class DeclRefExprVisitor : public FunctionPointVisit
 			Visitor.TraverseDecl(Node);
 
 			if(FunctionPointVisitor<Derived>::OverlapsWithPattern(Node)){
-				FunctionPoint* FunctionPoint = new InternalLogicalFile(
+				FunctionPoint* FunctionPoint = this -> Graph -> GetArena().template Create<InternalLogicalFile>(
 						Visitor.det,
 						Visitor.ret,
 						PrettyPrinter::PrintPretty(Node)
@@ -82,7 +85,7 @@ template <typename Derived> class DeclRefExprVisitor : public FunctionPointVisit
 
 				this -> FunctionPoints.push_back(FunctionPoint);
 			}else{
-				FunctionPoint* FunctionPoint = new ExternalInterfaceFile(
+				FunctionPoint* FunctionPoint = this -> Graph -> GetArena().template Create<ExternalInterfaceFile>(
 						Visitor.det,
 						Visitor.ret,
 						PrettyPrinter::PrintPretty(Node)
@@ -104,10 +107,12 @@ class DeclRefExprVisitorImplementation : public DeclRefExprVisitor<DeclRefExprVi
 		 * Creates a new instance of the visitor.
 		 *
 		 * @param myContext The context required when comparing two source locations.
+		 * @param myGraph The pattern graph owning the detected function points.
 		 * @param mySourceRange The range of the closest pattern code region.
 		 */
 		explicit DeclRefExprVisitorImplementation(
 				clang::ASTContext* myContext,
-				clang::SourceRange mySourceRange
+				PatternGraph* myGraph,
+				StableRange mySourceRange
 		);
 };
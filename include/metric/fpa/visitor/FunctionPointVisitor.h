@@ -3,6 +3,8 @@
 #include "clang/AST/RecursiveASTVisitor.h"
 #include "clang/Basic/SourceManager.h"
 #include "metric/fpa/FunctionPoint.h"
+#include "PatternGraph.h"
+#include "SourceFileTable.h"
 
 /**
  * Base class for the individual AST visitors.
@@ -13,16 +15,19 @@ template <typename Derived> class FunctionPointVisitor : public clang::Recursive
 		/**
 		 * Creates a new instance of the visitor.
 		 *
-		 * @param myContext The context required when comparing two source locations.
+		 * @param myContext The context required when translating the source locations.
+		 * @param myGraph The pattern graph owning the detected function points.
 		 * @param mySourceRange The range of the closest pattern code region.
 		 */
 		explicit FunctionPointVisitor(
 				clang::ASTContext* myContext,
-				clang::SourceRange mySourceRange
+				PatternGraph* myGraph,
+				StableRange mySourceRange
 		) :
 			CodeRegionSourceRange(mySourceRange),
-			IsBefore(myContext -> getSourceManager()),
-			Context(myContext){
+			Locations(myContext -> getSourceManager(), myGraph -> GetFileTable()),
+			Context(myContext),
+			Graph(myGraph){
 		}
 		/**
 		 * Contains all function points that have been detected by this visitor.
@@ -33,11 +38,11 @@ template <typename Derived> class FunctionPointVisitor : public clang::Recursive
 		/**
 		 * The source range of the closest pattern code region.
 		 */
-		clang::SourceRange CodeRegionSourceRange;
+		StableRange CodeRegionSourceRange;
 		/**
-		 * A helper function determining the order in which two source locations appear.
+		 * Translates the locations of the AST nodes, so they can be compared with the code region.
 		 */
-		clang::BeforeThanCompare<clang::SourceLocation> IsBefore;
+		StableLocationTranslator Locations;
 
 		/**
 		 * Checks if the source location is inside the code region.
@@ -45,11 +50,7 @@ template <typename Derived> class FunctionPointVisitor : public clang::Recursive
 		 * @return true if the location is enclosed by the pattern code region.
 		 */
 		bool Contains(clang::SourceLocation SourceLocation){
-			if(IsBefore(SourceLocation, CodeRegionSourceRange.getBegin()))
-				return (false);
-			if(IsBefore(CodeRegionSourceRange.getEnd(), SourceLocation))
-				return (false);
-			return (true);
+			return (CodeRegionSourceRange.Contains(Locations.Translate(SourceLocation, false)));
 		}
 
 		/**
@@ -89,6 +90,11 @@ template <typename Derived> class FunctionPointVisitor : public clang::Recursive
 		 */
 		clang::ASTContext* Context;
 
+		/**
+		 * The function points are created in the arena of this graph.
+		 */
+		PatternGraph* Graph;
+
 		/**
 		 * Checks if the provided source range intersects with the environment. I.e.
 		 * if it either start before or ends after the code region.
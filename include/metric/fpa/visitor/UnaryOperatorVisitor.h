@@ -13,9 +13,10 @@ class UnaryOperatorVisitor : public DeclRefExprVisitor<UnaryOperatorVisitor>{
 		 * Creates a new visitor for unary operators.
 		 *
 		 * @param myContext The context required when comparing two source locations.
+		 * @param myGraph The pattern graph owning the detected function points.
 		 * @param mySourceRange The range of the closest pattern code region.
 		 */
-		explicit UnaryOperatorVisitor(clang::ASTContext* myContext, clang::SourceRange mySourceRange);
+		explicit UnaryOperatorVisitor(clang::ASTContext* myContext, PatternGraph* myGraph, StableRange mySourceRange);
 		/**
 		 * Processes an unary operator. If this is the first occurrence of the operator, it will be treated as
 		 * a function point, with all children being its members.
@@ -11,9 +11,10 @@ class VarDeclVisitor : public DeclRefExprVisitor<VarDeclVisitor>{
 		 * Creates a new visitor for variable declarations.
 		 *
 		 * @param myContext The context required when comparing two source locations.
+		 * @param myGraph The pattern graph owning the detected function points.
 		 * @param mySourceRange The range of the closest pattern code region.
 		 */
-		explicit VarDeclVisitor(clang::ASTContext* myContext, clang::SourceRange mySourceRange);
+		explicit VarDeclVisitor(clang::ASTContext* myContext, PatternGraph* myGraph, StableRange mySourceRange);
 
 		/**
 		 * Processes a variable declaration. In case the variable is initialized, the declaration
@@ -9,8 +9,9 @@ class HalsteadVisitor : public ClangPatternVisitor<HalsteadVisitor>{
 		 *
 		 * @param myContext The context required when comparing two source locations.
 		 */
-		explicit HalsteadVisitor(
-				clang::ASTContext* myContext
+		HalsteadVisitor(
+				clang::ASTContext* myContext,
+				PatternGraph* myGraph
 		);
 		bool shouldVisitImplicitCode() const;
 		// -----------------------------------------------------------------------------
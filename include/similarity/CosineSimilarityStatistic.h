@@ -6,6 +6,7 @@
 class CosineSimilarityStatistic : public SimilarityMeasure {
 	public:
 		CosineSimilarityStatistic(
+				PatternGraph* myGraph,
 				PatternGraphNode* myRootPattern,
 				GraphSearchDirection mySearchDirection,
 				SimilarityCriterion mySimilarityCriterion
@@ -15,6 +15,7 @@
 class JaccardSimilarityStatistic : public SimilarityMeasure {
 	public:
 		JaccardSimilarityStatistic(
+				PatternGraph* myGraph,
 				PatternGraphNode* myRootPattern,
 				GraphSearchDirection mySearchDirection,
 				SimilarityCriterion mySimilarityCriterion
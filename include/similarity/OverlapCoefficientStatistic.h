@@ -6,6 +6,7 @@
 class OverlapCoefficientStatistic : public SimilarityMeasure {
 	public:
 		OverlapCoefficientStatistic(
+				PatternGraph* myGraph,
 				PatternGraphNode* myRootPattern,
 				GraphSearchDirection mySearchDirection,
 				SimilarityCriterion mySimilarityCriterion
@@ -6,6 +6,7 @@
 class WeightedJaccardSimilarityStatistic : public SimilarityMeasure {
 	public:
 	WeightedJaccardSimilarityStatistic(
+				PatternGraph* myGraph,
 				PatternGraphNode* myRootPattern,
 				GraphSearchDirection mySearchDirection,
 				SimilarityCriterion mySimilarityCriterion
@@ -2,11 +2,11 @@
 
 #include "similarity/visitor/CompositionVisitor.h"
 
-class BottomUpCompositionVisitor : public CompositionVisitor{
+class BottomUpCompositionVisitor : public CompositionVisitor<BottomUpCompositionVisitor>{
 	public:
 		explicit BottomUpCompositionVisitor(SimilarityCriterion mySimilarityCriterion);
-		void VisitPatternCodeRegion(PatternCodeRegion* Node) override;
-		void EndVisitPatternCodeRegion(PatternCodeRegion* Node) override;
+		void VisitPatternCodeRegion(PatternCodeRegion* Node);
+		void EndVisitPatternCodeRegion(PatternCodeRegion* Node);
 	private:
 		bool PatternCodeRegionIsLeaf;
 };
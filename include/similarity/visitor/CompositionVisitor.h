@@ -3,14 +3,40 @@
 #include "PatternGraph.h"
 #include "SimilarityMetrics.h"
 #include "similarity/PatternSequence.h"
+#include "visitor/IterativePatternGraphNodeVisitor.h"
 
 #include <vector>
 
-class CompositionVisitor : public PatternGraphNodeVisitor{
+/**
+ * Base class of the visitors that extract the pattern sequences for the similarity measures.
+ * @tparam Derived The visitor implementing this template.
+ */
+template <typename Derived> class CompositionVisitor : public IterativePatternGraphNodeVisitor<Derived>{
 	public:
-		explicit CompositionVisitor(SimilarityCriterion mySimilarityCriterion);
-		std::vector<PatternSequencePointer>& CalculatePatternSequences(PatternGraphNode* RootNode);
-		std::string ToString(PatternCodeRegion* Node);
+		explicit CompositionVisitor(SimilarityCriterion mySimilarityCriterion) :
+			Criterion(mySimilarityCriterion){
+		}
+
+		std::vector<PatternSequencePointer>& CalculatePatternSequences(PatternGraphNode* RootNode){
+			PatternSequences.clear();
+
+			this -> TraverseNode(RootNode);
+
+			return (PatternSequences);
+		}
+
+		std::string ToString(PatternCodeRegion* Node){
+			switch(Criterion){
+				case DesignSpace:
+					return (Node -> GetPatternOccurrence() -> GetPattern() -> GetDesignSpaceStr());
+					break;
+				case Pattern:
+					return (Node -> GetPatternOccurrence() -> GetPattern() -> GetPatternName());
+					break;
+				default:
+					return (Node -> GetID());
+			}
+		}
 	protected:
 		//Contains the code regions within a pattern sequence
 		std::vector<PatternCodeRegion*> SequenceCodeRegions;
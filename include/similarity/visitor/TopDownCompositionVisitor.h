@@ -2,10 +2,9 @@
 
 #include "similarity/visitor/CompositionVisitor.h"
 
-class TopDownCompositionVisitor : public CompositionVisitor{
+class TopDownCompositionVisitor : public CompositionVisitor<TopDownCompositionVisitor>{
 	public:
 		explicit TopDownCompositionVisitor(SimilarityCriterion mySimilarityCriterion);
-		void VisitPatternCodeRegion(PatternCodeRegion* Node) override;
-		void EndVisitPatternCodeRegion(PatternCodeRegion* Node) override;
-		void HandlePatternCodeRegion(PatternCodeRegion* Node) override;
+		void VisitPatternCodeRegion(PatternCodeRegion* Node);
+		void EndVisitPatternCodeRegion(PatternCodeRegion* Node);
 };
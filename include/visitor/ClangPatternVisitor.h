@@ -1,6 +1,7 @@
 #pragma once
 
 #include "PatternGraph.h"
+#include "SourceFileTable.h"
 #include "HPCPatternInstrASTTraversal.h"
 #include "visitor/PatternGraphNodeVisitor.h"
 #include "metric/fpa/PrettyPrinter.h"
@@ -18,53 +19,59 @@
  */
 template <typename Derived> class ClangPatternVisitor : public PatternGraphNodeVisitor, public clang::RecursiveASTVisitor<Derived>{
 	private:
-		clang::SourceManager& SourceManager;
+		/**
+		 * Translates the locations of the call expressions, so they can be compared
+		 * with the locations stored during the extraction of the pattern graph.
+		 */
+		StableLocationTranslator Locations;
 
-		bool Equals(clang::SourceLocation Source, clang::SourceLocation Target){
-			//Might be overkill and Source==Target may be enough,
-			//But I want to avoid undocumented sideeffects when possible
-			clang::FullSourceLoc FullSource(Source, SourceManager);
-			clang::FullSourceLoc FullTarget(Target, SourceManager);
-			return (FullSource == FullTarget);
-		}
+		/**
+		 * The code regions indexed by the location of their Pattern_Begin call.
+		 */
+		std::map<StableLocation, PatternCodeRegion*> RegionsByStart;
 
-		bool Equals(clang::CallExpr* CallExpression, PatternCodeRegion* PatternCodeRegion){
-			return (
-					Equals(CallExpression -> getBeginLoc(), PatternCodeRegion -> GetStartLoc()) ||
-					Equals(CallExpression -> getEndLoc(), PatternCodeRegion -> GetEndLoc())
-			);
-		}
+		/**
+		 * The code regions indexed by the end location of their Pattern_End call.
+		 */
+		std::map<StableLocation, PatternCodeRegion*> RegionsByEnd;
 
-		PatternCodeRegion* GetPatternCodeRegion(clang::CallExpr* Node){
-			//#TODO maybe store the code regions in a map with their range as key?
-			for(PatternCodeRegion* CodeRegion : PatternGraph::GetInstance() -> GetAllPatternCodeRegions()){
-				if(Equals(Node, CodeRegion))
-					return (CodeRegion);
-			}
-			return (NULL);
-		}
+	protected:
+		/**
+		 * The pattern graph of the analysis, which has been extracted before.
+		 */
+		PatternGraph* Graph;
 
 	public:
-		ClangPatternVisitor(clang::ASTContext* myContext) : SourceManager(myContext -> getSourceManager()){}
+		ClangPatternVisitor(clang::ASTContext* myContext, PatternGraph* myGraph) :
+			Locations(myContext -> getSourceManager(), myGraph -> GetFileTable()),
+			Graph(myGraph){
+			for(PatternCodeRegion* CodeRegion : myGraph -> GetAllPatternCodeRegions()){
+				if(CodeRegion -> GetStartLoc().IsValid())
+					RegionsByStart.emplace(CodeRegion -> GetStartLoc(), CodeRegion);
+				if(CodeRegion -> GetEndLoc().IsValid())
+					RegionsByEnd.emplace(CodeRegion -> GetEndLoc(), CodeRegion);
+			}
+		}
 
 		bool TraverseCallExpr(clang::CallExpr* Node){
-			PatternCodeRegion* PatternCodeRegion;
+			//Pattern_Begin
+			auto Start = RegionsByStart.find(Locations.Translate(Node -> getBeginLoc(), false));
+			if(Start != RegionsByStart.end()){
+				PatternCodeRegion* PatternCodeRegion = Start -> second;
+				VisitPatternCodeRegion(PatternCodeRegion);
+				VisitPatternOccurrence(PatternCodeRegion -> GetPatternOccurrence());
+				VisitParallelPattern(PatternCodeRegion -> GetPatternOccurrence() -> GetPattern());
+				return (true);
+			}
 
-			//Call expression is either a Pattern_Begin or Pattern_End
-			if((PatternCodeRegion = GetPatternCodeRegion(Node)) != NULL){
-				//Pattern_Begin
-				if(Equals(Node -> getBeginLoc(), PatternCodeRegion -> GetStartLoc())){
-					VisitPatternCodeRegion(PatternCodeRegion);
-					VisitPatternOccurrence(PatternCodeRegion -> GetPatternOccurrence());
-					VisitParallelPattern(PatternCodeRegion -> GetPatternOccurrence() -> GetPattern());
-					return (true);
-				//Pattern_End
-				}else{
-					EndVisitParallelPattern(PatternCodeRegion -> GetPatternOccurrence() -> GetPattern());
-					EndVisitPatternOccurrence(PatternCodeRegion -> GetPatternOccurrence());
-					EndVisitPatternCodeRegion(PatternCodeRegion);
-					return (true);
-				}
+			//Pattern_End
+			auto End = RegionsByEnd.find(Locations.Translate(Node -> getEndLoc(), false));
+			if(End != RegionsByEnd.end()){
+				PatternCodeRegion* PatternCodeRegion = End -> second;
+				EndVisitParallelPattern(PatternCodeRegion -> GetPatternOccurrence() -> GetPattern());
+				EndVisitPatternOccurrence(PatternCodeRegion -> GetPatternOccurrence());
+				EndVisitPatternCodeRegion(PatternCodeRegion);
+				return (true);
 			}
 
 			//Continue traversal if it isn't a Pattern_Begin or Pattern_End
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+/**
+ * Depth-first traversal of a graph or a tree with an explicit stack instead of recursion.
+ * The stack usage is bounded by the heap rather than by the call stack, so arbitrarily deep
+ * graphs can be traversed, and the frames of the nodes on the current path lie contiguously in memory.
+ *
+ * The traversal is configured with the curiously recurring template pattern: the class implementing this
+ * template passes itself as template argument and provides or hides the following methods.
+ * - size_t GetNumNeighbours(NodeType Node) and NodeType GetNeighbour(NodeType Node, size_t Index) (required)
+ *   describe the edges that are followed. The number of neighbours is read once, when the node is entered.
+ * - bool PreVisit(NodeType Node, int Depth) is called when a node is entered. If it returns false,
+ *   the neighbours of the node are not traversed and PostVisit() is not called for it.
+ * - void PostVisit(NodeType Node, int Depth) is called after all neighbours of the node have been traversed.
+ * - int GetNeighbourDepth(NodeType Node, int Depth) returns the depth of the neighbours of a node,
+ *   which is one more than the depth of the node by default. It is called once, when the node is entered.
+ *
+ * Nodes deeper than the maximum depth are not entered. If the neighbours of a node would be too deep, they are not
+ * even counted, so a traversal with a small maximum depth only costs time for the nodes it enters.
+ * The neighbours are visited in order, so the hooks
+ * are called in the same order as in a recursive implementation.
+ * The traversal must not be restarted from within one of the hooks.
+ * @tparam Derived The class implementing this template.
+ * @tparam NodeType The type of the nodes, e.g. a pointer or an index.
+ */
+template <typename Derived, typename NodeType> class DepthFirstTraversal{
+	public:
+		explicit DepthFirstTraversal(int myMaxDepth = std::numeric_limits<int>::max()) :
+			MaxDepth(myMaxDepth){
+		}
+
+		/**
+		 * Traverses all nodes reachable from the root.
+		 * @param Root The node the traversal starts with.
+		 * @param RootDepth The depth of the root node.
+		 */
+		void Traverse(NodeType Root, int RootDepth = 0){
+			Enter(Root, RootDepth);
+
+			while(!Stack.empty()){
+				Frame& Top = Stack.back();
+
+				if(Top.Next < Top.NumNeighbours){
+					NodeType Neighbour = getDerived().GetNeighbour(Top.Node, Top.Next++);
+					//Enter may grow the stack, so Top must not be used afterwards
+					Enter(Neighbour, Top.NeighbourDepth);
+				}else{
+					NodeType Node = Top.Node;
+					int Depth = Top.Depth;
+					Stack.pop_back();
+					getDerived().PostVisit(Node, Depth);
+				}
+			}
+		}
+
+		bool PreVisit(NodeType Node, int Depth){
+			static_cast<void>(Node); //Avoid unused parameter warning
+			static_cast<void>(Depth);
+			return (true);
+		}
+		void PostVisit(NodeType Node, int Depth){
+			static_cast<void>(Node); //Avoid unused parameter warning
+			static_cast<void>(Depth);
+		}
+		int GetNeighbourDepth(NodeType Node, int Depth){
+			static_cast<void>(Node); //Avoid unused parameter warning
+			return (Depth + 1);
+		}
+	protected:
+		Derived& getDerived(){ return *static_cast<Derived*>(this); }
+
+		void SetMaxDepth(int myMaxDepth){ MaxDepth = myMaxDepth; }
+	private:
+		/**
+		 * A node on the current path together with the position of the next neighbour.
+		 */
+		struct Frame{
+			NodeType Node;
+			int Depth;
+			int NeighbourDepth;
+			size_t Next;
+			size_t NumNeighbours;
+		};
+
+		void Enter(NodeType Node, int Depth){
+			if(Depth > MaxDepth)
+				return;
+
+			if(!getDerived().PreVisit(Node, Depth))
+				return;
+
+			int NeighbourDepth = getDerived().GetNeighbourDepth(Node, Depth);
+			size_t NumNeighbours = NeighbourDepth > MaxDepth ? 0 : getDerived().GetNumNeighbours(Node);
+			Stack.push_back(Frame{Node, Depth, NeighbourDepth, 0, NumNeighbours});
+		}
+
+		/**
+		 * The deepest depth at which nodes are still entered.
+		 */
+		int MaxDepth;
+		/**
+		 * The frames of the current path. The vector is kept between traversals to reuse its memory.
+		 */
+		std::vector<Frame> Stack;
+};
@@ -0,0 +1,130 @@
+#pragma once
+
+#include "PatternGraph.h"
+#include "HPCParallelPattern.h"
+#include "visitor/DepthFirstTraversal.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_set>
+
+/**
+ * A compile-time variant of the PatternGraphNodeVisitor, in the spirit of clang::RecursiveASTVisitor.
+ * The visitor implementing this template passes itself as template argument and hides the Visit and
+ * EndVisit methods it wants to customise. The nodes are dispatched by their kind instead of a virtual
+ * Accept() and all further calls are resolved statically, so they can be inlined.
+ * Start the traversal with TraverseNode().
+ *
+ * The graph is traversed with an explicit stack, so the depth of the graph is not limited by the call stack.
+ * As with the PatternGraphNodeVisitor, a code region is also visited as its pattern occurrence
+ * and its parallel pattern, and each function node is only traversed the first time it is reached.
+ * @tparam Derived The visitor implementing this template.
+ */
+template <typename Derived> class IterativePatternGraphNodeVisitor :
+	private DepthFirstTraversal<IterativePatternGraphNodeVisitor<Derived>, PatternGraphNode*>{
+	friend class DepthFirstTraversal<IterativePatternGraphNodeVisitor<Derived>, PatternGraphNode*>;
+	public:
+		IterativePatternGraphNodeVisitor() : Snapshot(NULL){
+		}
+
+		//The frozen graph of the analysis. Without a snapshot, the children vectors of the nodes are traversed.
+		void SetSnapshot(const PatternGraphSnapshot* mySnapshot){ Snapshot = mySnapshot; }
+
+		/**
+		 * Traverses the node and all of its descendants.
+		 * @param Node The node that is traversed.
+		 */
+		void TraverseNode(PatternGraphNode* Node){
+			this -> Traverse(Node);
+		}
+
+		void VisitParallelPattern(HPCParallelPattern* Node){
+			static_cast<void>(Node); //Avoid unused parameter warning
+		}
+		void EndVisitParallelPattern(HPCParallelPattern* Node){
+			static_cast<void>(Node); //Avoid unused parameter warning
+		}
+
+		void VisitPatternOccurrence(PatternOccurrence* Node){
+			static_cast<void>(Node); //Avoid unused parameter warning
+		}
+		void EndVisitPatternOccurrence(PatternOccurrence* Node){
+			static_cast<void>(Node); //Avoid unused parameter warning
+		}
+
+		void VisitPatternCodeRegion(PatternCodeRegion* Node){
+			static_cast<void>(Node); //Avoid unused parameter warning
+		}
+		void EndVisitPatternCodeRegion(PatternCodeRegion* Node){
+			static_cast<void>(Node); //Avoid unused parameter warning
+		}
+
+		void VisitFunctionNode(FunctionNode* Node){
+			static_cast<void>(Node); //Avoid unused parameter warning
+		}
+		void EndVisitFunctionNode(FunctionNode* Node){
+			static_cast<void>(Node); //Avoid unused parameter warning
+		}
+	protected:
+		Derived& getDerived(){ return *static_cast<Derived*>(this); }
+	private:
+		bool PreVisit(PatternGraphNode* Node, int Depth){
+			static_cast<void>(Depth); //Avoid unused parameter warning
+
+			if(PatternCodeRegion* CodeRegion = clang::dyn_cast<PatternCodeRegion>(Node)){
+				//Treat this as an inheritance visitor
+				//i.e. a Pattern Code Region is also a Pattern Occurrence and a Parallel Pattern
+				PatternOccurrence* Occurrence = CodeRegion -> GetPatternOccurrence();
+
+				getDerived().VisitParallelPattern(Occurrence -> GetPattern());
+				getDerived().VisitPatternOccurrence(Occurrence);
+				getDerived().VisitPatternCodeRegion(CodeRegion);
+				return (true);
+			}else if(FunctionNode* Function = clang::dyn_cast<FunctionNode>(Node)){
+				getDerived().VisitFunctionNode(Function);
+
+				//VisitedNodes.insert returns true if it's the first time the node is traversed
+				if(VisitedNodes.insert(Function -> GetHash()).second)
+					return (true);
+
+				getDerived().EndVisitFunctionNode(Function);
+			}
+
+			return (false);
+		}
+
+		void PostVisit(PatternGraphNode* Node, int Depth){
+			static_cast<void>(Depth); //Avoid unused parameter warning
+
+			if(PatternCodeRegion* CodeRegion = clang::dyn_cast<PatternCodeRegion>(Node)){
+				PatternOccurrence* Occurrence = CodeRegion -> GetPatternOccurrence();
+
+				getDerived().EndVisitPatternCodeRegion(CodeRegion);
+				getDerived().EndVisitPatternOccurrence(Occurrence);
+				getDerived().EndVisitParallelPattern(Occurrence -> GetPattern());
+			}else if(FunctionNode* Function = clang::dyn_cast<FunctionNode>(Node)){
+				getDerived().EndVisitFunctionNode(Function);
+			}
+		}
+
+		//The children of the node, using the frozen graph if available.
+		size_t GetNumNeighbours(PatternGraphNode* Node){
+			if(Snapshot != NULL && Snapshot -> Contains(Node))
+				return (Snapshot -> GetChildren(Node -> GetSnapshotIndex()).size());
+
+			return (Node -> GetChildren().size());
+		}
+
+		PatternGraphNode* GetNeighbour(PatternGraphNode* Node, size_t Index){
+			if(Snapshot != NULL && Snapshot -> Contains(Node))
+				return (Snapshot -> GetNode(Snapshot -> GetChildren(Node -> GetSnapshotIndex())[Index]));
+
+			return (Node -> GetChildren()[Index]);
+		}
+
+		//Function calls may be cyclic. In that case, only visit the first occurrence.
+		//We use the function IDs instead of pointers.
+		std::unordered_set<uint64_t> VisitedNodes;
+
+		const PatternGraphSnapshot* Snapshot;
+};
@@ -1,12 +1,15 @@
 #pragma once
 
 #include <set>
+#include <cstdint>
+#include <cstddef>
 #include "visitor/PatternOccurrenceVisitor.h"
 
 //Forward declaration due to PatternGraphNode::Accept(PatternGraphNodeVisitor);
 class PatternGraphNode;
 class PatternCodeRegion;
 class FunctionNode;
+class PatternGraphSnapshot;
 
 /**
  * This visitor is used to access all nodes in a given pattern graph.<br>
@@ -16,6 +19,11 @@ class FunctionNode;
  */
 class PatternGraphNodeVisitor : public PatternOccurrenceVisitor{
 	public:
+		PatternGraphNodeVisitor() : Snapshot(NULL){}
+
+		//The frozen graph of the analysis. Without a snapshot, the children vectors of the nodes are traversed.
+		void SetSnapshot(const PatternGraphSnapshot* mySnapshot){ Snapshot = mySnapshot; }
+
 		virtual void VisitPatternCodeRegion(PatternCodeRegion* Node);
 		virtual void TraversePatternCodeRegion(PatternCodeRegion* Node);
 		virtual void EndVisitPatternCodeRegion(PatternCodeRegion* Node);
@@ -25,8 +33,13 @@ class PatternGraphNodeVisitor : public PatternOccurrenceVisitor{
 		virtual void TraverseFunctionNode(FunctionNode* Node);
 		virtual void EndVisitFunctionNode(FunctionNode* Node);
 		virtual void HandleFunctionNode(FunctionNode* Node);
+	protected:
+		//Visits all children of the node, using the frozen graph if available.
+		void TraverseChildren(PatternGraphNode* Node);
 	private:
 		//Function calls may be cyclic. In that case, only visit the first occurrence.
-		//We use hash values instead of pointers.
-		std::set<unsigned> VisitedNodes;
+		//We use the function IDs instead of pointers.
+		std::set<uint64_t> VisitedNodes;
+
+		const PatternGraphSnapshot* Snapshot;
 }; 
@@ -0,0 +1,35 @@
+#include "AnalysisArena.h"
+
+#include "PatternGraph.h"
+#include "HPCParallelPattern.h"
+#include "metric/fpa/ExternalInput.h"
+#include "metric/fpa/ExternalOutput.h"
+#include "metric/fpa/ExternalInquiry.h"
+#include "metric/fpa/InternalLogicalFile.h"
+#include "metric/fpa/ExternalInterfaceFile.h"
+
+AnalysisArena::AnalysisArena()
+{
+
+}
+
+AnalysisArena::~AnalysisArena()
+{
+	/* The allocators run the destructors of their objects themselves */
+}
+
+void AnalysisArena::Reset()
+{
+	CallTreeNodes.Reset();
+	Identifications.Reset();
+	PatternCodeRegions.Reset();
+	PatternOccurrences.Reset();
+	Patterns.Reset();
+	FunctionNodes.Reset();
+
+	ExternalInputs.Reset();
+	ExternalOutputs.Reset();
+	ExternalInquiries.Reset();
+	InternalLogicalFiles.Reset();
+	ExternalInterfaceFiles.Reset();
+}
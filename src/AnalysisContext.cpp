@@ -0,0 +1,15 @@
+#include "AnalysisContext.h"
+
+AnalysisContext::AnalysisContext(AnalysisOptions Options) : Options(Options), Graph(), Stack(), Pairing(Graph.GetFileTable(), Options.StopAtFirstError), Tree(&Graph)
+{
+
+}
+
+void AnalysisContext::Clear()
+{
+	/* The call tree only refers to nodes in the arena of the graph, so it is emptied first */
+	Tree.Clear();
+	Stack.Clear();
+	Pairing.Clear();
+	Graph.Clear();
+}
@@ -0,0 +1,95 @@
+#include "CallTreeLinker.h"
+
+CallTreeLinker::CallTreeLinker(CallTree* Tree) : Tree(Tree)
+{
+	/* The declaration vector also contains the Pattern_Begin nodes, which never match a call */
+	for (CallTreeNode* Declaration : *Tree->GetDeclarationVector())
+	{
+		if (Declaration->GetNodeType() == Function_Decl || Declaration->GetNodeType() == Root)
+		{
+			Declarations[Declaration->GetID()->getIdentificationHash()].push_back(Declaration);
+		}
+	}
+}
+
+void CallTreeLinker::Link(CallTreeNode* Root)
+{
+	Enter(Root);
+
+	while (!Frames.empty())
+	{
+		Frame& Top = Frames.back();
+		size_t NumSuccessors = Top.Node->GetNodeType() == Function ? Top.Targets.size() : Top.Node->GetCallees()->Size();
+
+		if (Top.Next == NumSuccessors)
+		{
+			Frames.pop_back();
+			continue;
+		}
+
+		CallTreeNode* Successor = Top.Node->GetNodeType() == Function ? Top.Targets[Top.Next] : (*Top.Node->GetCallees())[Top.Next];
+		Top.Next++;
+
+		if (!Visited.count(Successor))
+		{
+			/* Enter may grow the frames, so Top must not be used afterwards */
+			Enter(Successor);
+		}
+	}
+}
+
+void CallTreeLinker::Enter(CallTreeNode* Node)
+{
+	Visited.insert(Node);
+	Frames.push_back(Frame{Node, std::vector<CallTreeNode*>(), 0});
+
+	if (Node->GetNodeType() == Function)
+	{
+		LinkCall(Node, Frames.back().Targets);
+	}
+}
+
+void CallTreeLinker::LinkCall(CallTreeNode* Call, std::vector<CallTreeNode*>& Targets)
+{
+	FunctionID Callee = Call->GetID()->getIdentificationHash();
+	const OverriderIndex& Overriders = Tree->GetGraph()->GetOverriderIndex();
+
+	if (!Call->IsVirtualCall() || Overriders.IsEmpty())
+	{
+		AppendDeclarations(Call, Callee, Targets);
+		return;
+	}
+
+	/* A virtual call is linked to the declarations of the called method and of all its overriders */
+	std::vector<FunctionID> Candidates;
+	Overriders.GetDispatchCandidates(Callee, Candidates);
+
+	for (FunctionID Candidate : Candidates)
+	{
+		AppendDeclarations(Call, Candidate, Targets);
+	}
+}
+
+void CallTreeLinker::AppendDeclarations(CallTreeNode* Call, FunctionID Function, std::vector<CallTreeNode*>& Targets)
+{
+	auto Entry = Declarations.find(Function);
+
+	if (Entry == Declarations.end())
+	{
+		return;
+	}
+
+	/* A call of main is linked to the root */
+	CallTreeNode* RootNode = Tree->getRoot();
+	CallTreeNode* Declaration = RootNode != NULL && RootNode->compare(Function) ? RootNode : Entry->second.front();
+
+	Call->insertCallee(Declaration);
+
+	/* The first call that reaches a declaration becomes its caller, so the callers form a tree below the root */
+	if (Declaration->GetCaller() == NULL && Declaration != RootNode)
+	{
+		Declaration->SetCaller(Call);
+	}
+
+	Targets.insert(Targets.end(), Entry->second.begin(), Entry->second.end());
+}
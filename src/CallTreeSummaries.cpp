@@ -0,0 +1,117 @@
+#include "CallTreeSummaries.h"
+#include "PatternGraph.h"
+
+#include <algorithm>
+#include <limits>
+
+CallTreeSubtreeSummary CallTreeSummaries::Get(CallTreeNode* Node)
+{
+	auto Cached = Cache.find(Node);
+
+	if (Cached != Cache.end())
+	{
+		return Cached->second;
+	}
+
+	CallTreeSubtreeSummary Result;
+	Enter(Node);
+
+	while (!Frames.empty())
+	{
+		Frame& Top = Frames.back();
+		CalleeList* Callees = Top.Node->GetCallees();
+
+		if (Top.Next < Callees->Size())
+		{
+			CallTreeNode* Callee = (*Callees)[Top.Next];
+			Top.Next++;
+
+			auto CachedCallee = Cache.find(Callee);
+
+			if (CachedCallee != Cache.end())
+			{
+				/* A shared subtree which is already summarised */
+				Merge(Top.Summary, CachedCallee->second);
+			}
+			else if (OnPath.count(Callee))
+			{
+				Top.LowestCut = std::min(Top.LowestCut, OnPath[Callee]);
+			}
+			else
+			{
+				/* Enter may grow the frames, so Top must not be used afterwards */
+				Enter(Callee);
+			}
+
+			continue;
+		}
+
+		CallTreeNode* Finished = Top.Node;
+		CallTreeSubtreeSummary Summary = Top.Summary;
+		size_t LowestCut = Top.LowestCut;
+		size_t FirstPending = Top.FirstPending;
+		Frames.pop_back();
+		OnPath.erase(Finished);
+
+		if (LowestCut < Frames.size())
+		{
+			/* The expansion was cut at a call further up the path, so the summary is incomplete */
+			if (IsShared(Finished))
+			{
+				Pending.push_back(Finished);
+			}
+		}
+		else
+		{
+			/* Finished is not part of a cycle or the first node of its cycle on the path, so its summary is complete.
+			 * All declarations of the cycle, which have been finished below it, share the summary. */
+			if (IsShared(Finished))
+			{
+				Cache[Finished] = Summary;
+			}
+
+			for (size_t Member = FirstPending; Member < Pending.size(); Member++)
+			{
+				Cache[Pending[Member]] = Summary;
+			}
+
+			Pending.resize(FirstPending);
+		}
+
+		if (Frames.empty())
+		{
+			Result = Summary;
+		}
+		else
+		{
+			Frames.back().LowestCut = std::min(Frames.back().LowestCut, LowestCut);
+			Merge(Frames.back().Summary, Summary);
+		}
+	}
+
+	return Result;
+}
+
+void CallTreeSummaries::Clear()
+{
+	Cache.clear();
+}
+
+void CallTreeSummaries::Enter(CallTreeNode* Node)
+{
+	CallTreeSubtreeSummary Summary;
+	Summary.ContainsPatterns = Node->GetNodeType() == Pattern_Begin || Node->GetNodeType() == Pattern_End;
+
+	OnPath[Node] = Frames.size();
+	Frames.push_back(Frame{Node, 0, Summary, std::numeric_limits<size_t>::max(), Pending.size()});
+}
+
+void CallTreeSummaries::Merge(CallTreeSubtreeSummary& Caller, const CallTreeSubtreeSummary& Callee)
+{
+	Caller.ContainsPatterns = Caller.ContainsPatterns || Callee.ContainsPatterns;
+}
+
+bool CallTreeSummaries::IsShared(CallTreeNode* Node)
+{
+	return Node->GetNodeType() == Function_Decl || Node->GetNodeType() == Root;
+}
@@ -0,0 +1,71 @@
+#include "CalleeList.h"
+
+#include <algorithm>
+
+bool CalleeList::PushBack(CallTreeNode* Node)
+{
+	if (!Members.insert(Node).second)
+	{
+		return false;
+	}
+
+	Nodes.push_back(Node);
+	return true;
+}
+
+bool CalleeList::Insert(size_t Position, CallTreeNode* Node)
+{
+	if (!Members.insert(Node).second)
+	{
+		return false;
+	}
+
+	Nodes.insert(Nodes.begin() + std::min(Position, Nodes.size()), Node);
+	return true;
+}
+
+size_t CalleeList::IndexOf(CallTreeNode* Node) const
+{
+	if (!Contains(Node))
+	{
+		return Nodes.size();
+	}
+
+	return std::find(Nodes.begin(), Nodes.end(), Node) - Nodes.begin();
+}
+
+size_t CalleeList::SpliceTail(size_t First, CalleeList& Dest, size_t Position)
+{
+	if (First >= Nodes.size())
+	{
+		return 0;
+	}
+
+	/* Filter the moved range first, so Dest grows by a single insertion */
+	std::vector<CallTreeNode*> Moved;
+	Moved.reserve(Nodes.size() - First);
+
+	for (size_t Index = First; Index < Nodes.size(); Index++)
+	{
+		CallTreeNode* Node = Nodes[Index];
+		Members.erase(Node);
+
+		if (Dest.Members.insert(Node).second)
+		{
+			Moved.push_back(Node);
+		}
+	}
+
+	Nodes.erase(Nodes.begin() + First, Nodes.end());
+
+	Position = std::min(Position, Dest.Nodes.size());
+	Dest.Nodes.insert(Dest.Nodes.begin() + Position, Moved.begin(), Moved.end());
+
+	return Moved.size();
+}
+
+void CalleeList::Clear()
+{
+	Nodes.clear();
+	Members.clear();
+}
@@ -1,5 +1,4 @@
 #include "HPCError.h"
-//#include "HPCRunningStats.h"
 
 TooManyEndsException::TooManyEndsException(std::string ID){
   this->ID = ID;
@@ -71,3 +70,20 @@ void missingPatternEnd::printPatternWithNoEnd() const{
     }
   }
 };
+
+GraphFileException::GraphFileException(std::string FileName, std::string Reason){
+  this->Message = "\033[31mCould not access the pattern graph file " + FileName + ": " + Reason + "\033[0m";
+};
+
+const char* GraphFileException::what() const throw(){
+  return this->Message.c_str();
+};
+
+PatternStringException::PatternStringException(std::string PatternString, size_t Position, std::string Reason){
+  this->Message = "\033[31mMalformed pattern string \"" + PatternString + "\" at position " + std::to_string(Position) + ": " + Reason + "\033[0m";
+  this->Position = Position;
+};
+
+const char* PatternStringException::what() const throw(){
+  return this->Message.c_str();
+};
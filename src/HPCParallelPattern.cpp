@@ -210,8 +210,6 @@ void PatternOccurrence::Print()
 /*
  * Pattern Code Region Class Functions
  */
-PatternCodeRegion::~PatternCodeRegion(){std::cout << "Deleted CodeRegion" << '\n';}
-
 PatternCodeRegion::PatternCodeRegion(PatternOccurrence* PatternOcc) : PatternGraphNode(GNK_Pattern), Parents(), Children()
 {
 	this->PatternOcc = PatternOcc;
@@ -223,76 +221,29 @@ void PatternCodeRegion::Accept(PatternGraphNodeVisitor* Visitor){
 
 void PatternCodeRegion::AddChild(PatternGraphNode* Child)
 {
-	/*Before we add a child we look if this child has not been registered already
+	/*Code regions with the same identifier and the same function node are only registered once as a child
 			*/
-	if(PatternCodeRegion* ChildCodeReg = clang::dyn_cast<PatternCodeRegion>(Child))
-	{
-		for(PatternGraphNode* PatFor : this->Children){
-			if(PatternCodeRegion* PatRegFor = clang::dyn_cast<PatternCodeRegion>(PatFor))
-			{
-					if(PatRegFor->GetID()== ChildCodeReg->GetID()) return;
-			}
-		}
-	}
-	else
-	{
-		FunctionNode* ChildFunc = clang::dyn_cast<FunctionNode>(Child);
-		for(PatternGraphNode* PatFor : this->Children){
-			if(FunctionNode* PatFuncFor = clang::dyn_cast<FunctionNode>(PatFor))
-			{
-				if(PatFuncFor->GetHash() == ChildFunc->GetHash()) return;
-			}
-		}
-	}
-	Children.push_back(Child);
+	Children.Insert(Child, Child->GetEdgeKey());
 }
 
 
 void PatternCodeRegion::AddParent(PatternGraphNode* Parent)
 {
-	/*Before we add a child we look if this child has not been registered already
+	/*Code regions with the same identifier and the same function node are only registered once as a parent
 			*/
-	if(PatternCodeRegion* ParentCodeReg = clang::dyn_cast<PatternCodeRegion>(Parent))
-	{
-		for(PatternGraphNode* PatFor : this->Parents){
-			if(PatternCodeRegion* PatRegFor = clang::dyn_cast<PatternCodeRegion>(PatFor))
-			{
-					if(PatRegFor->GetID()== ParentCodeReg->GetID()) return;
-			}
-		}
-	}
-	else
-	{
-		FunctionNode* ParentFunc = clang::dyn_cast<FunctionNode>(Parent);
-		for(PatternGraphNode* PatFor : this->Parents){
-			if(FunctionNode* PatFuncFor = clang::dyn_cast<FunctionNode>(PatFor))
-			{
-				if(PatFuncFor->GetHash() == ParentFunc->GetHash()) return;
-			}
-		}
-	}
-	Parents.push_back(Parent);
+	Parents.Insert(Parent, Parent->GetEdgeKey());
 }
 
 void PatternCodeRegion::AddOnlyPatternChild(PatternGraphNode* PatChild)
-{/*Before we add a child we look if this child has not been registered already
-		*/
-		PatternCodeRegion* PatternChild = clang::dyn_cast<PatternCodeRegion>(PatChild);
-		for(PatternCodeRegion* PatRegFor : this->PatternChildren){
-			if(PatRegFor->GetID() == PatternChild->GetID()) return;
-		}
-		this->PatternChildren.push_back(PatternChild);
-
+{
+	PatternCodeRegion* PatternChild = clang::dyn_cast<PatternCodeRegion>(PatChild);
+	this->PatternChildren.Insert(PatternChild, PatternChild->GetEdgeKey());
 }
 
 void PatternCodeRegion::AddOnlyPatternParent(PatternGraphNode* PatParent)
-{/*Before we add a parent we look if this parent has not been registered already
-	*/
+{
 	PatternCodeRegion* PatternParent = clang::dyn_cast<PatternCodeRegion>(PatParent);
-	for(PatternCodeRegion* PatRegFor : this->PatternParents){
-		if(PatRegFor->GetID() == PatternParent->GetID()) return;
-	}
-	this->PatternParents.push_back(PatternParent);
+	this->PatternParents.Insert(PatternParent, PatternParent->GetEdgeKey());
 }
 
 
@@ -312,12 +263,12 @@ void PatternCodeRegion::SetLastLine(int LastLine)
 	this->LinesOfCode = (LastLine - this->LinesOfCode) - 1;
 }
 
-void PatternCodeRegion::SetStartSourceLoc(clang::SourceLocation StartLoc)
+void PatternCodeRegion::SetStartSourceLoc(StableLocation StartLoc)
 {
 	this->StartSLocation = StartLoc;
 }
 
-void PatternCodeRegion::SetEndSourceLoc(clang::SourceLocation EndLoc){
+void PatternCodeRegion::SetEndSourceLoc(StableLocation EndLoc){
 	this->EndSLocation = EndLoc;
 }
 
@@ -330,23 +281,23 @@ void PatternCodeRegion::Print()
 	std::cout << this->GetLinesOfCode() << " lines of code." << std::endl;
 }
 
-clang::SourceLocation PatternCodeRegion::GetStartLoc(){
+StableLocation PatternCodeRegion::GetStartLoc(){
 	return this->StartSLocation;
 }
 
-clang::SourceLocation PatternCodeRegion::GetEndLoc(){
+StableLocation PatternCodeRegion::GetEndLoc(){
 	return this->EndSLocation;
 }
 
 bool PatternCodeRegion::HasNoPatternParents(){
-	if(this->PatternParents.size()){
+	if(this->PatternParents.Size()){
 		return false;
 	}
 	return true;
 }
 
 bool PatternCodeRegion::HasNoPatternChildren(){
-	if(this->PatternChildren.size()){
+	if(this->PatternChildren.Size()){
 		return false;
 	}
 	return true;
@@ -365,20 +316,17 @@ void PatternCodeRegion::PrintVecOfPattern(std::vector<PatternCodeRegion*> Region
 /*
  * Pattern Stack Management
  */
-std::vector<PatternCodeRegion*> PatternContext;
-std::vector<PatternCodeRegion*> OnlyPatternContext;
-
 /**
  * @brief Add a PatternCodeRegion to the top of the pattern context stack.
  *
  * @param PatternReg Code Region to be placed on the stack.
  **/
-void AddToPatternStack(PatternCodeRegion* PatternReg)
+void PatternStack::AddToPatternStack(PatternCodeRegion* PatternReg)
 {
 	PatternContext.push_back(PatternReg);
 }
 
-void AddToOnlyPatternStack(PatternCodeRegion* PatternReg)
+void PatternStack::AddToOnlyPatternStack(PatternCodeRegion* PatternReg)
 {
 
 	OnlyPatternContext.push_back(PatternReg);
@@ -389,7 +337,7 @@ void AddToOnlyPatternStack(PatternCodeRegion* PatternReg)
  *
  * @return Top PatternCodeRegion or NULL if stack is empty.
  **/
-PatternCodeRegion* GetTopPatternStack()
+PatternCodeRegion* PatternStack::GetTopPatternStack()
 {
 	if (!PatternContext.empty())
 	{
@@ -398,7 +346,7 @@ PatternCodeRegion* GetTopPatternStack()
 		return NULL;
 }
 
-PatternCodeRegion* GetTopOnlyPatternStack(){
+PatternCodeRegion* PatternStack::GetTopOnlyPatternStack(){
 	if (!OnlyPatternContext.empty())
 	{
 		return OnlyPatternContext.back();
@@ -411,7 +359,7 @@ PatternCodeRegion* GetTopOnlyPatternStack(){
  *
  * @param ID The suspected ID of the pattern context top.
  **/
-void RemoveFromPatternStack(std::string ID)
+void PatternStack::RemoveFromPatternStack(std::string ID)
 {
 	if (!PatternContext.empty())
 	{
@@ -435,7 +383,7 @@ void RemoveFromPatternStack(std::string ID)
 	}
 }
 
-void RemoveFromOnlyPatternStack(std::string ID){
+void PatternStack::RemoveFromOnlyPatternStack(std::string ID){
 	if(!OnlyPatternContext.empty())
 	{
 		// we need to compare if the ID is the same as the ID of the Pattern that we inserted first in the stack
@@ -462,8 +410,14 @@ void RemoveFromOnlyPatternStack(std::string ID){
 	}
 }
 
-PatternCodeRegion* PatternIDisUsed(std::string ID){
-	std::vector<PatternCodeRegion*> PatternCodeRegions = PatternGraph::GetInstance()->GetAllPatternCodeRegions();
+void PatternStack::Clear()
+{
+	PatternContext.clear();
+	OnlyPatternContext.clear();
+}
+
+PatternCodeRegion* PatternIDisUsed(PatternGraph* Graph, std::string ID){
+	std::vector<PatternCodeRegion*> PatternCodeRegions = Graph->GetAllPatternCodeRegions();
 	for(PatternCodeRegion* PatCodeReg : PatternCodeRegions){
 		if(!(ID.compare(PatCodeReg->GetID()))){
 			return PatCodeReg;
@@ -473,6 +427,6 @@ PatternCodeRegion* PatternIDisUsed(std::string ID){
 }
 
 
-clang::SourceRange PatternCodeRegion::GetSourceRange(){
-	return (clang::SourceRange(StartSLocation, EndSLocation));
+StableRange PatternCodeRegion::GetSourceRange(){
+	return (StableRange(StartSLocation, EndSLocation));
 }
@@ -7,12 +7,12 @@
 
 #include <iostream>
 #include "clang/AST/RawCommentList.h"
+#include "clang/AST/ExprCXX.h"
 #include "llvm/ADT/StringRef.h"
 #include "clang/Basic/SourceManager.h"
 #include "clang/Basic/SourceLocation.h"
 #include <string>
 #include "llvm/ADT/SmallVector.h"
-#include "HPCRunningStats.h"
 
 #ifndef HPCERROR_H
 #include "HPCError.h"
@@ -30,6 +30,12 @@
 
 bool HPCPatternInstrVisitor::VisitFunctionDecl(clang::FunctionDecl *Decl)
 {
+	/* Prototypes and other redeclarations without a body are merged with their definition */
+	if (!Decl->doesThisDeclarationHaveABody())
+	{
+		return true;
+	}
+
 	clang::SourceManager& SourceMan = Context->getSourceManager();
 	if(SourceMan.isInMainFile(Decl->getBeginLoc()))
 	{
@@ -38,18 +44,25 @@ bool HPCPatternInstrVisitor::VisitFunctionDecl(clang::FunctionDecl *Decl)
 		clang::SourceManager& SourceMan = Context->getSourceManager();
 		clang::FullSourceLoc SourceLoc(beginLoc, SourceMan);
 		CallTreeNode* Node;
+		CallTree& ClTre = Analysis->GetCallTree();
+		PatternCodeRegion* Top = Analysis->GetPatternStack().GetTopPatternStack();
 
-		if ((CurrentFnEntry = PatternGraph::GetInstance()->GetFunctionNode(Decl)) == NULL)
+		CurrentFnEntry = LookupFunctionNode(Decl);
+
+		/* Virtual calls of the overridden methods may be dispatched to this method */
+		if (clang::CXXMethodDecl* Method = clang::dyn_cast<clang::CXXMethodDecl>(Decl))
 		{
-			PatternGraph::GetInstance()->RegisterFunction(Decl);
-			CurrentFnEntry = PatternGraph::GetInstance()->GetFunctionNode(Decl);
+			if (Method->isVirtual())
+			{
+				Analysis->GetGraph().RegisterOverrides(Method);
+			}
 		}
 		if(Decl->isMain()){
-			Node = ClTre->registerNode(Root, CurrentFnEntry, LastNodeType, GetTopPatternStack(), CurrentFnEntry);
-			ClTre->setRootNode(Node);
+			Node = ClTre.registerNode(Root, CurrentFnEntry, LastNodeType, Top, CurrentFnEntry);
+			ClTre.setRootNode(Node);
 		}
 		else
-			Node = ClTre->registerNode(Function_Decl, CurrentFnEntry, LastNodeType, GetTopPatternStack(), CurrentFnEntry);
+			Node = ClTre.registerNode(Function_Decl, CurrentFnEntry, LastNodeType, Top, CurrentFnEntry);
 
 		Node->SetLineNumber(SourceLoc.getLineNumber());
 		#ifdef LOCDEBUG
@@ -69,7 +82,7 @@ bool HPCPatternInstrVisitor::VisitFunctionDecl(clang::FunctionDecl *Decl)
 
 /**
  * @brief When we encounter a call expression, we look up the declaration of the function called.
- * If it is one of our instrumentation functions, we extract the information from the string argument with ASTMatchers.
+ * If it is one of our instrumentation functions, we extract the information from the string argument.
  * A PatternCodeRegion object is created if this is the start of a region or the current region is closed.
  * For a non-instrumentation function, the function is added to the pattern which surraunds it as a child.
  * If there is no pattern, the function is a direct child of the calling function.
@@ -81,6 +94,8 @@ bool HPCPatternInstrVisitor::VisitFunctionDecl(clang::FunctionDecl *Decl)
 bool HPCPatternInstrVisitor::VisitCallExpr(clang::CallExpr *CallExpr)
 {
 	clang::SourceManager& SourceMan = Context->getSourceManager();
+	CallTree& ClTre = Analysis->GetCallTree();
+	PatternStack& Stack = Analysis->GetPatternStack();
 
 	/*If Clause is used to make shure that only the code in compile_commands.json is traversed
 	  and no used libraries*/
@@ -94,29 +109,33 @@ bool HPCPatternInstrVisitor::VisitCallExpr(clang::CallExpr *CallExpr)
 			std::cout << Callee->getNameInfo().getName().getAsString() << std::endl;
 	#endif
 
-			std::string FnName = Callee->getNameInfo().getName().getAsString();
+			InstrumentationCall Instrumentation = GetInstrumentationCall(Callee);
 
 			// If the CallExpr is a pattern-begin expression
-			if (!FnName.compare(PATTERN_BEGIN_CXX_FNNAME) || !FnName.compare(PATTERN_BEGIN_C_FNNAME))
+			if (Instrumentation == PatternBeginCall)
 			{
-				/*Delivers the children of the current node*/
-				clang::Expr** Args = CallExpr->getArgs();
+				const clang::StringLiteral* PatternStr = GetPatternString(CallExpr);
 	#ifdef PRINT_DEBUG
-				Args[0]->dump();
+				PatternStr->dump();
 	#endif
-				/*calls all registered callbacks on all matches on the given node.
-				  this call is pretty stong. It creates the patternCodeRegion and if there is no mathing PatternOccurrence it
+				/*this call is pretty stong. It creates the patternCodeRegion and if there is no mathing PatternOccurrence it
 					is creating one. Also are the Child parent relations set with this call*/
-				//PatternBeginFinder is a  clang::ast_matchers::MatchFinder which uses a HPCPatternBeginInstrHandler to set everything up and the Pattern is also registered in the patternStack.
+				//The HPCPatternBeginInstrHandler sets everything up and the Pattern is also registered in the patternStack.
 				PatternCodeRegion* PatBeforethisPat = PatternBeginHandler.GetLastPattern();
 
-				PatternBeginFinder.match(*Args[0], *Context);
+				try{
+					PatternBeginHandler.run(PatternStr->getString());
+				}
+				catch(PatternStringException& e){
+					ReportPatternStringError(PatternStr, e);
+					throw TerminateEarlyException();
+				}
 
 				PatternCodeRegion* PatternCodeReg = PatternBeginHandler.GetLastPattern();
 
 				/* Store this PatternCodeRegion Begin in the CallTree (ClTre)*/
 
-				CallTreeNode* BeginNode = ClTre->registerNode(Pattern_Begin, PatternCodeReg, LastNodeType, PatBeforethisPat, CurrentFnEntry);
+				CallTreeNode* BeginNode = ClTre.registerNode(Pattern_Begin, PatternCodeReg, LastNodeType, PatBeforethisPat, CurrentFnEntry);
 
 
 				/* Get the location of the fn call which denotes the beginning of this pattern */
@@ -129,45 +148,52 @@ bool HPCPatternInstrVisitor::VisitCallExpr(clang::CallExpr *CallExpr)
 					std::cout << "setted LineNumber of: "<< *BeginNode->GetID()<<" to "<< SourceLoc.getLineNumber()<<" verification: "<<BeginNode->getLineNumber()<< '\n';
 				#endif
 				PatternCodeReg->SetFirstLine(SourceLoc.getLineNumber());
-				PatternCodeReg->SetStartSourceLoc(LocStart);
+				PatternCodeReg->SetStartSourceLoc(Locations.Translate(LocStart));
+
+				Analysis->GetPairingValidator().Begin(PatternCodeReg, PatternCodeReg->GetStartLoc(), CurrentFnEntry);
 
 
 				PatternCodeReg->isInMain = SourceMan.isInMainFile(LocStart);
 				LastNodeType = Pattern_Begin;
 			}
-			else if (!FnName.compare(PATTERN_END_CXX_FNNAME) || !FnName.compare(PATTERN_END_C_FNNAME))
+			else if (Instrumentation == PatternEndCall)
 			{
-				clang::Expr** Args = CallExpr->getArgs();
+				const clang::StringLiteral* PatternStr = GetPatternString(CallExpr);
 				#ifdef PRINT_DEBUG
-							std::cout << "Degub dump of Args before matching" << '\n';
-							Args[0]->dump();
+							std::cout << "Degub dump of the pattern string" << '\n';
+							PatternStr->dump();
 				#endif
+				/* Get the location of the fn call which denotes the end of this pattern */
+				clang::SourceManager& SourceMan = Context->getSourceManager();
+				clang::SourceLocation LocEnd = CallExpr->getEndLoc();
+				clang::FullSourceLoc SourceLoc(LocEnd, SourceMan);
+				StableLocation EndLoc = Locations.Translate(LocEnd);
+
+				/* The pairing is checked before the pattern stacks are changed, an unpaired Pattern_End is reported and skipped */
+				PatternCodeRegion* ClosedCodeReg = Analysis->GetPairingValidator().End(PatternStr->getString().str(), EndLoc, CurrentFnEntry);
+
+				if (ClosedCodeReg == NULL)
+				{
+					return true;
+				}
+
 				PatternCodeRegion* PatternCodeReg;
 				try{
-					PatternEndFinder.match(*Args[0], *Context);
+					PatternEndHandler.run(PatternStr->getString());
 					PatternCodeReg = PatternEndHandler.GetLastPattern();
 				}
 				catch(TooManyEndsException& e){
 					e.what();
 					throw TerminateEarlyException();
 				}
-				#ifdef PRINT_DEBUG
-				std::cout << "Degub dump of Args after matching" << '\n';
-							Args[0]->dump();
-				#endif
 
-				/* Get the location of the fn call which denotes the end of this pattern */
-				clang::SourceManager& SourceMan = Context->getSourceManager();
-				clang::SourceLocation LocEnd = CallExpr->getEndLoc();
-				clang::FullSourceLoc SourceLoc(LocEnd, SourceMan);
-
-				CallTreeNode* EndNode = ClTre->registerEndNode(Pattern_End, PatternEndHandler.GetLastPatternID(), LastNodeType, PatternCodeReg, CurrentFnEntry);
+				CallTreeNode* EndNode = ClTre.registerEndNode(Pattern_End, PatternEndHandler.GetLastPatternID(), LastNodeType, PatternCodeReg, CurrentFnEntry);
 				EndNode->SetLineNumber(SourceLoc.getLineNumber());
 				#ifdef LOCDEBUG
 					std::cout << "setted LineNumber of: "<< *EndNode->GetID()<<" to "<< SourceLoc.getLineNumber()<<" verification: "<<EndNode->getLineNumber()<< '\n';
 				#endif
-				PatternCodeReg->SetLastLine(SourceLoc.getLineNumber());
-				PatternCodeReg->SetEndSourceLoc(LocEnd);
+				ClosedCodeReg->SetLastLine(SourceLoc.getLineNumber());
+				ClosedCodeReg->SetEndSourceLoc(EndLoc);
 			}
 			// If no: search the called function for patterns
 			else
@@ -176,53 +202,33 @@ bool HPCPatternInstrVisitor::VisitCallExpr(clang::CallExpr *CallExpr)
 				FunctionNode* Func;
 
 				/*if the function is not registered register*/
-				if ((Func = PatternGraph::GetInstance()->GetFunctionNode(Callee)) == NULL)
-				{
-					PatternGraph::GetInstance()->RegisterFunction(Callee);
-				}
-				Func = PatternGraph::GetInstance()->GetFunctionNode(Callee);
+				Func = LookupFunctionNode(Callee);
 
 	#ifdef PRINT_DEBUG
 				std::cout << Func->GetFnName() << " (" << Func->GetHash() << ")" << std::endl;
 	#endif
 
-				/* Store this function call in the CallTree (ClTre)*/
-				CallTreeNode* FuncNode = ClTre->registerNode(Function, Func, LastNodeType, GetTopPatternStack(), CurrentFnEntry);
-
 				clang::SourceManager& SourceMan = Context->getSourceManager();
 				clang::SourceLocation LocStart = CallExpr->getBeginLoc();
 				clang::FullSourceLoc SourceLoc(LocStart, SourceMan);
-				FuncNode->SetLineNumber(SourceLoc.getLineNumber());
+
+				/* Store this function call in the CallTree (ClTre), repeated calls may be merged into one node*/
+				ClTre.registerCall(Func, IsVirtualCall(CallExpr), SourceLoc.getLineNumber(), Analysis->GetOptions().MergeCallSites, LastNodeType, Stack.GetTopPatternStack(), CurrentFnEntry);
 
 				PatternCodeRegion* Top;
 				/* if we are within a Pattern -> register this Functon as a child of the pattern etc. */
-				if ((Top = GetTopPatternStack()) != NULL)
+				if ((Top = Stack.GetTopPatternStack()) != NULL)
 				{
 					Top->AddChild(Func);
 					Func->AddParent(Top);
-
-					Func->AddPatternParent(Top);
-					#ifdef DEBUG_J
-					std::cout << Func->GetFnName()<< " hat als PatternParent: " << Top->GetID()<< '\n';
-					#endif
 				}
 				else
 				{/*if not register this function as a child for the function in which we currenty are
 					 (because we are always inside a function this is possible)
+					 The pattern parents of the function are composed from these relations after the traversal, see PatternTransferComposition.
 					 */
 					CurrentFnEntry->AddChild(Func);
 					Func->AddParent(CurrentFnEntry);
-
-					/*if the parent of this function has a PatternParent, the function inherits it to its child (Func) */
-					if(!CurrentFnEntry->HasNoPatternParents()){
-						//function has PatternParents too
-						Func->AddPatternParents(CurrentFnEntry->GetPatternParents());
-						/*If the function has PatternParents AND PatternChildre, we register the the GetPatternChildren
-							as Children of the PatternParents vice versa*/
-						if(!Func->HasNoPatternChildren()){
-							Func->registerPatChildrenToPatParents();
-						}
-					}
 				}
 			}
 		}
@@ -231,11 +237,115 @@ bool HPCPatternInstrVisitor::VisitCallExpr(clang::CallExpr *CallExpr)
 	return true;
 }
 
-HPCPatternInstrVisitor::HPCPatternInstrVisitor (clang::ASTContext* Context) :
-		Context(Context){
-	using namespace clang::ast_matchers;
-	StatementMatcher StringArgumentMatcher = hasDescendant(stringLiteral().bind("patternstr"));
+FunctionNode* HPCPatternInstrVisitor::LookupFunctionNode(clang::FunctionDecl* Decl)
+{
+	clang::FunctionDecl* Canonical = Decl->getCanonicalDecl();
+	FunctionNode*& Entry = FunctionNodes[Canonical];
+
+	if (Entry == NULL)
+	{
+		Entry = Analysis->GetGraph().GetOrRegisterFunction(Canonical);
+	}
+
+	return Entry;
+}
+
+bool HPCPatternInstrVisitor::IsVirtualCall(clang::CallExpr* CallExpr)
+{
+	clang::CXXMemberCallExpr* MemberCall = clang::dyn_cast<clang::CXXMemberCallExpr>(CallExpr);
+
+	if (MemberCall == NULL)
+	{
+		return false;
+	}
+
+	clang::CXXMethodDecl* Method = MemberCall->getMethodDecl();
+
+	if (Method == NULL || !Method->isVirtual())
+	{
+		return false;
+	}
+
+	/* A qualified call like Base::Method() is dispatched statically */
+	if (clang::MemberExpr* Member = clang::dyn_cast<clang::MemberExpr>(MemberCall->getCallee()->IgnoreParens()))
+	{
+		return !Member->hasQualifier();
+	}
+
+	return true;
+}
+
+HPCPatternInstrVisitor::InstrumentationCall HPCPatternInstrVisitor::GetInstrumentationCall(const clang::FunctionDecl* Callee) const
+{
+	/* Operators, constructors etc. have no identifier */
+	const clang::IdentifierInfo* Identifier = Callee->getIdentifier();
+
+	if (Identifier == NULL)
+	{
+		return NoInstrumentation;
+	}
+
+	if (Identifier == PatternBeginIdentifiers[0] || Identifier == PatternBeginIdentifiers[1])
+	{
+		return PatternBeginCall;
+	}
+
+	if (Identifier == PatternEndIdentifiers[0] || Identifier == PatternEndIdentifiers[1])
+	{
+		return PatternEndCall;
+	}
+
+	return NoInstrumentation;
+}
+
+const clang::StringLiteral* HPCPatternInstrVisitor::GetPatternString(clang::CallExpr* CallExpr)
+{
+	const clang::Expr* Arg = CallExpr->getNumArgs() > 0 ? CallExpr->getArg(0) : NULL;
+
+	while (Arg != NULL)
+	{
+		Arg = Arg->IgnoreImplicit()->IgnoreParenImpCasts();
+
+		if (const clang::StringLiteral* PatternStr = clang::dyn_cast<clang::StringLiteral>(Arg))
+		{
+			/* Only narrow string literals can be read as a string */
+			if (PatternStr->getCharByteWidth() == 1)
+			{
+				return PatternStr;
+			}
+
+			break;
+		}
+
+		/* e.g. a std::string constructed from the literal */
+		const clang::CXXConstructExpr* Construct = clang::dyn_cast<clang::CXXConstructExpr>(Arg);
+		Arg = Construct != NULL && Construct->getNumArgs() > 0 ? Construct->getArg(0) : NULL;
+	}
+
+	clang::FullSourceLoc SourceLoc(CallExpr->getBeginLoc(), Context->getSourceManager());
+	std::cout << "\033[31m" << SourceLoc.printToString(Context->getSourceManager()) << ": The argument of an instrumentation call has to be a string literal.\033[0m" << std::endl;
+	throw TerminateEarlyException();
+}
+
+void HPCPatternInstrVisitor::ReportPatternStringError(const clang::StringLiteral* PatternStr, const PatternStringException& Error)
+{
+	clang::SourceManager& SourceMan = Context->getSourceManager();
+	clang::SourceLocation ErrorLoc = PatternStr->getLocationOfByte(Error.GetPosition(), SourceMan, Context->getLangOpts(), Context->getTargetInfo());
+
+	std::cout << ErrorLoc.printToString(SourceMan) << ": " << Error.what() << std::endl;
+}
 
-	PatternBeginFinder.addMatcher(StringArgumentMatcher, &PatternBeginHandler);
-	PatternEndFinder.addMatcher(StringArgumentMatcher, &PatternEndHandler);
+HPCPatternInstrVisitor::HPCPatternInstrVisitor (clang::ASTContext* Context, AnalysisContext* Analysis) :
+		Context(Context),
+		Analysis(Analysis),
+		Locations(Context->getSourceManager(), Analysis->GetGraph().GetFileTable()),
+		PatternBeginHandler(Analysis),
+		PatternEndHandler(Analysis){
+	/* IdentifierTable::get() returns the same object for every occurrence of the name in this translation unit */
+	clang::IdentifierTable& Identifiers = Context->Idents;
+
+	PatternBeginIdentifiers[0] = &Identifiers.get(PATTERN_BEGIN_CXX_FNNAME);
+	PatternBeginIdentifiers[1] = &Identifiers.get(PATTERN_BEGIN_C_FNNAME);
+	PatternEndIdentifiers[0] = &Identifiers.get(PATTERN_END_CXX_FNNAME);
+	PatternEndIdentifiers[1] = &Identifiers.get(PATTERN_END_C_FNNAME);
 }
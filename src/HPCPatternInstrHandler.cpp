@@ -1,18 +1,11 @@
 #include "HPCPatternInstrHandler.h"
 #include "HPCParallelPattern.h"
 #include "HPCError.h"
+#include "PatternString.h"
 #include <iostream>
-#include <regex>
 //#define PRINT_ONLYPATTERNDENUG
 
 
-/*
- * Regular Expressions
- */
-std::regex BeginParallelPatternRegex("([[:alnum:]]+)\\s([[:alnum:]]+)\\s([[:alnum:]]+)");
-std::regex EndParallelPatternRegex("([[:alnum:]]+)");
-
-
 
 /**
  * @brief Keep track of the currently encountered function.
@@ -25,24 +18,22 @@ void HPCPatternBeginInstrHandler::SetCurrentFnEntry(FunctionNode* FnEntry)
 }
 
  // describes what has to happen if we encounter the beginning of a pattern
-void HPCPatternBeginInstrHandler::run(const clang::ast_matchers::MatchFinder::MatchResult &Result)
+void HPCPatternBeginInstrHandler::run(llvm::StringRef PatternString)
 {
-	const clang::StringLiteral* patternstr = Result.Nodes.getNodeAs<clang::StringLiteral>("patternstr");
-
+	PatternGraph* Graph = &Analysis->GetGraph();
+	PatternStack& Stack = Analysis->GetPatternStack();
 
-	/* Match Regex and save info*/
-	std::smatch MatchRes;
-	std::string PatternInfoStr = patternstr->getString().str();
 
-	std::regex_search(PatternInfoStr, MatchRes, BeginParallelPatternRegex);
+	/* Tokenize the string and save info*/
+	PatternBeginString PatternInfo = ParsePatternBeginString(PatternString);
 
-	DesignSpace DesignSp = StrToDesignSpace(MatchRes[1].str());
-	std::string PatternName = MatchRes[2].str();
-	std::string PatternID = MatchRes[3].str();
+	DesignSpace DesignSp = PatternInfo.DesignSp;
+	std::string PatternName = PatternInfo.PatternName;
+	std::string PatternID = PatternInfo.PatternID;
 
 	/*We look if this patternCodeRegion ID is already used*/
 	try{
-		if(PatternIDisUsed(PatternID)){
+		if(PatternIDisUsed(Graph, PatternID)){
 			throw TooManyBeginsException(PatternID);
 		}
 	}
@@ -51,23 +42,23 @@ void HPCPatternBeginInstrHandler::run(const clang::ast_matchers::MatchFinder::Ma
 		throw TerminateEarlyException();
 	}
 	/* Look if a pattern with this Design Space and Name already exists */
-	HPCParallelPattern* Pattern = PatternGraph::GetInstance()->GetPattern(DesignSp, PatternName);
+	HPCParallelPattern* Pattern = Graph->GetPattern(DesignSp, PatternName);
 
 	/*If Pattern does not exist register it.*/
 	if (Pattern == NULL)
 	{
-		Pattern = new HPCParallelPattern(DesignSp, PatternName);
-		PatternGraph::GetInstance()->RegisterPattern(Pattern);
+		Pattern = Graph->GetArena().Create<HPCParallelPattern>(DesignSp, PatternName);
+		Graph->RegisterPattern(Pattern);
 	}
 
 
 	/* Check if this code regions is part of an existing pattern occurrence */
-	PatternOccurrence* PatternOcc = PatternGraph::GetInstance()->GetPatternOccurrence(PatternID);
+	PatternOccurrence* PatternOcc = Graph->GetPatternOccurrence(PatternID);
 
 	if (PatternOcc == NULL)
 	{
-		PatternOcc = new PatternOccurrence(Pattern, PatternID);
-		PatternGraph::GetInstance()->RegisterPatternOccurrence(PatternOcc);
+		PatternOcc = Graph->GetArena().Create<PatternOccurrence>(Pattern, PatternID);
+		Graph->RegisterPatternOccurrence(PatternOcc);
 		Pattern->AddOccurrence(PatternOcc);
 	}
 	else
@@ -85,12 +76,12 @@ void HPCPatternBeginInstrHandler::run(const clang::ast_matchers::MatchFinder::Ma
 	}
 
 	/* Create a new object for pattern occurrence */
-	PatternCodeRegion* CodeRegion = new PatternCodeRegion(PatternOcc);
+	PatternCodeRegion* CodeRegion = Graph->GetArena().Create<PatternCodeRegion>(PatternOcc);
 	PatternOcc->AddCodeRegion(CodeRegion);
 
 
 	/* Connect the child and parent links between the objects */
-	PatternCodeRegion* Top = GetTopPatternStack();
+	PatternCodeRegion* Top = Stack.GetTopPatternStack();
 
 	if (Top != NULL)
 	{
@@ -102,14 +93,13 @@ void HPCPatternBeginInstrHandler::run(const clang::ast_matchers::MatchFinder::Ma
 		CurrentFnEntry->AddChild(CodeRegion);
 		CodeRegion->AddParent(CurrentFnEntry);
 
-		/*Register the PatternChildren of the Functions too*/
+		/*Register the PatternChildren of the Functions too, they are connected to the pattern parents in PatternTransferComposition*/
 		CurrentFnEntry->AddPatternChild(CodeRegion);
-		CurrentFnEntry->registerPatChildrenToPatParents();
 	}
 
-	AddToPatternStack(CodeRegion);
+	Stack.AddToPatternStack(CodeRegion);
 
-	PatternCodeRegion* OnlyPatternTop = GetTopOnlyPatternStack();
+	PatternCodeRegion* OnlyPatternTop = Stack.GetTopOnlyPatternStack();
 
 	if(OnlyPatternTop != NULL)
 	{
@@ -118,10 +108,10 @@ void HPCPatternBeginInstrHandler::run(const clang::ast_matchers::MatchFinder::Ma
 	}
 	else
 	{
-		PatternGraph::GetInstance()->RegisterOnlyPatternRootNode(CodeRegion);
+		Graph->RegisterOnlyPatternRootNode(CodeRegion);
 	}
 
-	AddToOnlyPatternStack(CodeRegion);
+	Stack.AddToOnlyPatternStack(CodeRegion);
 
 #if PRINT_DEBUG
 	Pattern->Print();
@@ -130,17 +120,17 @@ void HPCPatternBeginInstrHandler::run(const clang::ast_matchers::MatchFinder::Ma
 #endif
 }
 
-void HPCPatternEndInstrHandler::run(const clang::ast_matchers::MatchFinder::MatchResult &Result)
+void HPCPatternEndInstrHandler::run(llvm::StringRef PatternString)
 {
-	const clang::StringLiteral* patternstr = Result.Nodes.getNodeAs<clang::StringLiteral>("patternstr");
+	PatternStack& Stack = Analysis->GetPatternStack();
 
-	LastPatternID = patternstr->getString().str();
-	LastPattern = GetTopPatternStack();
+	LastPatternID = PatternString.str();
+	LastPattern = Stack.GetTopPatternStack();
 
-	RemoveFromPatternStack(LastPatternID);
+	Stack.RemoveFromPatternStack(LastPatternID);
 
-	LastOnlyPattern = GetTopOnlyPatternStack();
-	RemoveFromOnlyPatternStack(LastPatternID);
+	LastOnlyPattern = Stack.GetTopOnlyPatternStack();
+	Stack.RemoveFromOnlyPatternStack(LastPatternID);
 }
 
 void HPCPatternEndInstrHandler::SetCurrentFnEntry(FunctionNode* FnEntry)
@@ -5,10 +5,53 @@
 
 //#define LOCDEBUG
 //#define PRINT_DEBUG
+
+const PatternGraphSnapshot& HPCPatternStatistic::GetSnapshot()
+{
+	if (Graph->GetSnapshot() == NULL)
+	{
+		Graph->Freeze();
+	}
+
+	return *Graph->GetSnapshot();
+}
+
+void PerPatternStatistic::Calculate()
+{
+	BeginCalculation();
+	CalculatePatterns(0, Patterns.size());
+	EndCalculation();
+}
+
+void PerPatternStatistic::BeginCalculation()
+{
+	/* The patterns may be calculated concurrently, so the snapshot has to exist before */
+	GetSnapshot();
+
+	Patterns = Graph->GetAllPatterns();
+	PrepareResults(Patterns.size());
+}
+
+void PerPatternStatistic::CalculatePatterns(size_t Begin, size_t End)
+{
+	for (size_t Index = Begin; Index < End; Index++)
+	{
+		CalculatePattern(Index, Patterns[Index]);
+	}
+}
+
+void PerPatternStatistic::EndCalculation()
+{
+	for (size_t Index = 0; Index < Patterns.size(); Index++)
+	{
+		StoreResult(Index, Patterns[Index]);
+	}
+}
+
 /*
  * Methods for the Cyclomatic Complexity Statistic
  */
-CyclomaticComplexityStatistic::CyclomaticComplexityStatistic() : VisitedNodes()
+CyclomaticComplexityStatistic::CyclomaticComplexityStatistic(PatternGraph* myGraph) : HPCPatternStatistic(myGraph)
 {
 
 }
@@ -43,65 +86,52 @@ void CyclomaticComplexityStatistic::CSVExport(std::string FileName)
 	File.close();
 }
 
-void CyclomaticComplexityStatistic::SetNodeVisited(PatternGraphNode* Node)
-{
-	if (!IsNodeVisited(Node))
-	{
-		VisitedNodes.push_back(Node);
-	}
-}
-
-bool CyclomaticComplexityStatistic::IsNodeVisited(PatternGraphNode* Node)
-{
-	for (PatternGraphNode* N : VisitedNodes)
-	{
-		if (N == Node)
-		{
-			return true;
-		}
-	}
-
-	return false;
-}
-
 int CyclomaticComplexityStatistic::CountEdges()
 {
-	/* Start the tree traversal from all functions */
-	std::vector<FunctionNode*> Functions = PatternGraph::GetInstance()->GetAllFunctions();
+	const PatternGraphSnapshot& Snapshot = GetSnapshot();
+	std::vector<bool> Visited(Snapshot.GetNumNodes(), false);
 
 	int edges = 0;
 
-	for (FunctionNode* Fn : Functions)
+	/* Start the tree traversal from all functions */
+	for (PatternGraphSnapshot::NodeIndex Fn = 0; Fn < Snapshot.GetNumFunctions(); Fn++)
 	{
-		edges += CountEdges(Fn);
+		edges += CountEdges(Fn, Visited);
 	}
 
 	return edges;
 }
 
-int CyclomaticComplexityStatistic::CountEdges(PatternGraphNode* Current)
+int CyclomaticComplexityStatistic::CountEdges(PatternGraphSnapshot::NodeIndex Root, std::vector<bool>& Visited)
 {
+	const PatternGraphSnapshot& Snapshot = GetSnapshot();
+	std::vector<PatternGraphSnapshot::NodeIndex> Stack(1, Root);
+
 	int Edges = 0;
 
-	/* If we visit a pattern, add the incoming edge */
-	if (clang::dyn_cast<PatternCodeRegion>(Current) != NULL)
+	while (!Stack.empty())
 	{
-		Edges = Edges + 1;
-	}
+		PatternGraphSnapshot::NodeIndex Current = Stack.back();
+		Stack.pop_back();
 
-	/* If we already visited this node, then just return 1 if this is a pattern, 0 else */
-	if (IsNodeVisited(Current))
-	{
-		return Edges;
-	}
-	else
-	{
-		SetNodeVisited(Current);
+		/* If we visit a pattern, add the incoming edge */
+		if (Snapshot.IsCodeRegion(Current))
+		{
+			Edges = Edges + 1;
+		}
+
+		/* If we already visited this node, the edges beginning from it have been counted */
+		if (Visited[Current])
+		{
+			continue;
+		}
+
+		Visited[Current] = true;
 
 		/* Count the Edges beginning from the children */
-		for (PatternGraphNode* Child : Current->GetChildren())
+		for (PatternGraphSnapshot::NodeIndex Child : Snapshot.GetChildren(Current))
 		{
-			Edges += CountEdges(Child);
+			Stack.push_back(Child);
 		}
 	}
 
@@ -110,15 +140,14 @@ int CyclomaticComplexityStatistic::CountEdges(PatternGraphNode* Current)
 
 int CyclomaticComplexityStatistic::CountNodes()
 {
-	std::vector<HPCParallelPattern*> Patterns = PatternGraph::GetInstance()->GetAllPatterns();
+	const PatternGraphSnapshot& Snapshot = GetSnapshot();
 
 	int nodes = 0;
 
 	/* Count all occurrences for all patterns */
-	for (HPCParallelPattern* Pattern : Patterns)
+	for (unsigned Pattern = 0; Pattern < Snapshot.GetNumPatterns(); Pattern++)
 	{
-		std::vector<PatternCodeRegion*> CodeRegs = Pattern->GetCodeRegions();
-		nodes += CodeRegs.size();
+		nodes += Snapshot.GetCodeRegionsOfPattern(Pattern).size();
 	}
 
 	return nodes;
@@ -126,33 +155,10 @@ int CyclomaticComplexityStatistic::CountNodes()
 
 int CyclomaticComplexityStatistic::CountConnectedComponents()
 {
-	GraphAlgorithms::MarkConnectedComponents();
-
-	std::vector<PatternCodeRegion*> CodeRegs = PatternGraph::GetInstance()->GetAllPatternCodeRegions();
-	std::vector<FunctionNode*> Functions = PatternGraph::GetInstance()->GetAllFunctions();
+	int ConnectedComponents = GetSnapshot().GetNumConnectedComponents();
 
-	int ConnectedComponents = 0;
-
-	/* Get CCs from the code regions */
-	for (PatternCodeRegion* Reg : CodeRegs)
-	{
-		if (Reg->GetConnectedComponent() > ConnectedComponents)
-		{
-			ConnectedComponents = Reg->GetConnectedComponent();
-		}
-	}
-
-	/* Also check the function calls */
-	for (FunctionNode* Fn : Functions)
-	{
-		if (Fn->GetConnectedComponent() > ConnectedComponents)
-		{
-			ConnectedComponents = Fn->GetConnectedComponent();
-		}
-	}
-
-	/* Return highest index + 1 (null based index) */
-	return ConnectedComponents + 1;
+	/* The highest index + 1, where an empty graph still counts as one component */
+	return ConnectedComponents > 0 ? ConnectedComponents : 1;
 }
 
 
@@ -160,6 +166,11 @@ int CyclomaticComplexityStatistic::CountConnectedComponents()
 /*
  * Methods for the lines of code statistic
  */
+LinesOfCodeStatistic::LinesOfCodeStatistic(PatternGraph* myGraph) : HPCPatternStatistic(myGraph)
+{
+
+}
+
 void LinesOfCodeStatistic::Calculate()
 {
 
@@ -167,7 +178,7 @@ void LinesOfCodeStatistic::Calculate()
 
 void LinesOfCodeStatistic::Print()
 {
-	std::vector<HPCParallelPattern*> Patterns = PatternGraph::GetInstance()->GetAllPatterns();
+	std::vector<HPCParallelPattern*> Patterns = Graph->GetAllPatterns();
 
 	for (HPCParallelPattern* Pattern : Patterns)
 	{
@@ -192,7 +203,7 @@ void LinesOfCodeStatistic::CSVExport(std::string FileName)
 
 	File << "Patternname" << CSV_SEPARATOR_CHAR << "NumRegions" << CSV_SEPARATOR_CHAR << "LOCByRegions" << CSV_SEPARATOR_CHAR << "TotalLOCs\n";
 
-	std::vector<HPCParallelPattern*> Patterns = PatternGraph::GetInstance()->GetAllPatterns();
+	std::vector<HPCParallelPattern*> Patterns = Graph->GetAllPatterns();
 
 	for (HPCParallelPattern* Pattern : Patterns)
 	{
@@ -223,7 +234,7 @@ void LinesOfCodeStatistic::CSVExport(std::string FileName)
 /*
  * Methods for the simple pattern counter
  */
-SimplePatternCountStatistic::SimplePatternCountStatistic()
+SimplePatternCountStatistic::SimplePatternCountStatistic(PatternGraph* myGraph) : HPCPatternStatistic(myGraph)
 {
 
 }
@@ -235,7 +246,7 @@ void SimplePatternCountStatistic::Calculate()
 
 void SimplePatternCountStatistic::Print()
 {
-	std::vector<HPCParallelPattern*> Patterns = PatternGraph::GetInstance()->GetAllPatterns();
+	std::vector<HPCParallelPattern*> Patterns = Graph->GetAllPatterns();
 
 	for (HPCParallelPattern* Pattern : Patterns)
 	{
@@ -250,7 +261,7 @@ void SimplePatternCountStatistic::CSVExport(std::string FileName)
 
 	File << "Patternname" << CSV_SEPARATOR_CHAR << "Count\n";
 
-	std::vector<HPCParallelPattern*> Patterns = PatternGraph::GetInstance()->GetAllPatterns();
+	std::vector<HPCParallelPattern*> Patterns = Graph->GetAllPatterns();
 
 	for (HPCParallelPattern* Pattern : Patterns)
 	{
@@ -261,17 +272,18 @@ void SimplePatternCountStatistic::CSVExport(std::string FileName)
 }
 
 
-FanInFanOutStatistic::FanInFanOutStatistic(int maxdepth) : FIFOCounter()
+FanInFanOutStatistic::FanInFanOutStatistic(PatternGraph* myGraph, int maxdepth) : HPCPatternStatistic(myGraph), FIFOCounter()
 {
 	this->maxdepth = maxdepth;
 }
 
 void FanInFanOutStatistic::Calculate()
 {
-	std::vector<HPCParallelPattern*> Patterns = PatternGraph::GetInstance()->GetAllPatterns();
+	const PatternGraphSnapshot& Snapshot = GetSnapshot();
 
-	for (HPCParallelPattern* Pattern : Patterns)
+	for (unsigned PatternIndex = 0; PatternIndex < Snapshot.GetNumPatterns(); PatternIndex++)
 	{
+		HPCParallelPattern* Pattern = Snapshot.GetPattern(PatternIndex);
 		FanInFanOutCounter* Counter = LookupFIFOCounter(Pattern);
 
 		if (Counter == NULL)
@@ -283,8 +295,14 @@ void FanInFanOutStatistic::Calculate()
 		std::vector<PatternOccurrence*> Parents;
 		std::vector<PatternOccurrence*> Children;
 
-		for (PatternCodeRegion* CodeReg : GetCodeRegions(Pattern))
+		for (PatternGraphSnapshot::NodeIndex Region : Snapshot.GetCodeRegionsOfPattern(PatternIndex))
 		{
+			if (!Snapshot.IsSuitedForNestingStatistics(Region))
+			{
+				continue;
+			}
+
+			PatternCodeRegion* CodeReg = Snapshot.GetCodeRegion(Region);
 #ifdef PRINT_DEBUG
 			CodeReg->Print();
 			std::cout << std::endl;
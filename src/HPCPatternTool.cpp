@@ -3,6 +3,7 @@
 #include "TreeVisualisation.h"
 #include "HPCPatternStatistics.h"
 #include "HPCParallelPattern.h"
+#include "PatternGraphFile.h"
 #include "Helpers.h"
 #include "SimilarityMetrics.h"
 #include "metric/FunctionPointAnalysisStatistic.h"
@@ -15,25 +16,26 @@
 #include "similarity/WeightedJaccardSimilarityStatistic.h"
 
 #include "ToolInformation.h"
-#ifndef HPCRUNNINGSTATS_H
-  #include "HPCRunningStats.h"
-#endif
-//#include "HPCRunningStats.h"
+#include "AnalysisContext.h"
+#include "MemoryReport.h"
+#include "PatternTransferComposition.h"
+#include "StatisticScheduler.h"
 
 #include <iostream>
+#include <memory>
 #include "clang/Tooling/Tooling.h"
 #include "clang/Tooling/CommonOptionsParser.h"
 #include "llvm/Support/CommandLine.h"
 #include "clang/Tooling/ArgumentsAdjusters.h"
 #include "clang/ASTFrontendDelegatorAction.h"
 #include "clang/ASTFrontendInstrumentationAction.h"
+#include "clang/AnalysisActionFactory.h"
 
 #ifndef HPCERROR_H
 #include "HPCError.h"
 #endif
 
 //#define DEBUG
-int  MAX_DEPTH = 8;
 
 /**
  * @mainpage Clang Pattern Instrumentation Tool
@@ -59,7 +61,8 @@ int  MAX_DEPTH = 8;
  *  A pattern occurrence can rather consist of many PatternCodeRegion with the same identifier.
  * -# The code regions instrumented in the code are represnted by PatternCodeRegion objects in our tool. Every code region belongs to an occurrence which 'has' a pattern.
  *
- * Another central class is the PatternGraph singleton class, which holds structual information about the patterns extracted from the analysed sourcecode. It provides access to lists of all patterns, all occurrences and all code regions. Further, it holds a reference to a designated root node for tree or analysis purposes.
+ * Another central class is the PatternGraph class, which holds structual information about the patterns extracted from the analysed sourcecode. It provides access to lists of all patterns, all occurrences and all code regions. Further, it holds a reference to a designated root node for tree or analysis purposes.
+ * The graph, the call tree and the options of one analysis are owned by an AnalysisContext, which is passed to every step of the analysis.
  *
  * Own statistics or similarity measures can easily be implemented. Statistics should inherit from HPCPatternStatistic and similarity measures from SimilarityMeasure. The statistic classes can then be registered in the tool's main function, where they are initialised and the calculations are executed.
  *
@@ -88,6 +91,14 @@ static llvm::cl::OptionCategory maxTreeDisplayDepth("Sets maximal depth to displ
 static llvm::cl::extrahelp HelpMaxTreeDisplayDepth("This only changes the depth with which the tree is displayed. The other statistics are still using the whole tree.");
 static llvm::cl::opt<unsigned int> MaxTreeDisplayDepth("maxTreeDisplayDepth", llvm::cl::cat(maxTreeDisplayDepth));
 
+static llvm::cl::OptionCategory compactTree("Prints repeated subtrees only once");
+static llvm::cl::extrahelp HelpCompactTree("-compactTree Use this flag, if a subtree that occurs more than once in a tree should only be printed the first time. It is labelled with a number, e.g. #12, and every further occurrence refers back to it with -> see #12\n \n");
+static llvm::cl::opt<bool> CompactTree("compactTree", llvm::cl::cat(compactTree));
+
+static llvm::cl::OptionCategory maxTreeChildren("Sets the maximal number of children of a node to display");
+static llvm::cl::extrahelp HelpMaxTreeChildren("-maxTreeChildren=<n> Only the first n children of a node are printed, the others are summarised in one line. 0 prints all children\n \n");
+static llvm::cl::opt<unsigned int> MaxTreeChildren("maxTreeChildren", llvm::cl::cat(maxTreeChildren));
+
 static llvm::cl::OptionCategory displayCompilationsList("Displays every File in the compilation database");
 static llvm::cl::extrahelp HelpDisplayCompilationsList("Use this option to be shure that every file which you want to analyze is in the compilation database. If not ur file is not analyzed by the tool and you should add this file in your compile_commands.json file");
 static llvm::cl::opt<bool> DisplayCompilationsList("displayCompilationsList", llvm::cl::cat(displayCompilationsList));
@@ -100,38 +111,229 @@ static llvm::cl::OptionCategory relationTree("Output the relation tree");
 static llvm::cl::extrahelp HelpRelationTree("-relationTree Use this flag, if you want to see the relation tree\n \n");
 static llvm::cl::opt<bool> RelationTree("relationTree", llvm::cl::cat(noTree));
 
-static HPCPatternStatistic* Statistics[] = {
-		new SimplePatternCountStatistic(),
-		new FanInFanOutStatistic(20),
-		new LinesOfCodeStatistic(),
-		new CyclomaticComplexityStatistic(),
-		new FunctionPointAnalysisStatistic(),
-		new CohesionStatistic(),
-		new HalsteadStatistic()
-};
+static llvm::cl::OptionCategory saveGraph("Saves the analysed pattern graph to a file");
+static llvm::cl::extrahelp HelpSaveGraph("-saveGraph=<file> Use this option to store the pattern graph and the call tree after the analysis, so the statistics can be computed again with -loadGraph\n \n");
+static llvm::cl::opt<std::string> SaveGraph("saveGraph", llvm::cl::cat(saveGraph));
+
+static llvm::cl::OptionCategory loadGraph("Loads a saved pattern graph instead of analysing the sources");
+static llvm::cl::extrahelp HelpLoadGraph("-loadGraph=<file> Use this option to print the tree, the statistics and the similarity measures of a graph stored with -saveGraph. The sources are not parsed again\n \n");
+static llvm::cl::opt<std::string> LoadGraph("loadGraph", llvm::cl::cat(loadGraph));
+
+static llvm::cl::OptionCategory mergeCallSites("Merges repeated calls of a function in the call tree");
+static llvm::cl::extrahelp HelpMergeCallSites("-mergeCallSites Use this flag, if the calls of the same function within the same function or code region should be one node of the call tree. The node counts the calls and keeps their line numbers\n \n");
+static llvm::cl::opt<bool> MergeCallSites("mergeCallSites", llvm::cl::cat(mergeCallSites));
+
+static llvm::cl::OptionCategory stopAtFirstError("Stops the analysis at the first unpaired Pattern_Begin or Pattern_End");
+static llvm::cl::extrahelp HelpStopAtFirstError("-stopAtFirstError Use this flag, if the traversal of the sources should stop at the first Pattern_Begin or Pattern_End that is not paired. Without it, all of them are reported before the analysis stops\n \n");
+static llvm::cl::opt<bool> StopAtFirstError("stopAtFirstError", llvm::cl::cat(stopAtFirstError));
+
+static llvm::cl::OptionCategory statisticThreads("Sets the number of threads that calculate the statistics");
+static llvm::cl::extrahelp HelpStatisticThreads("-statisticThreads=<n> The statistics and similarity measures are calculated on n threads. 0 uses one thread per hardware thread, 1 calculates them one after another. With -memReport they are always calculated one after another\n \n");
+static llvm::cl::opt<unsigned int> StatisticThreads("statisticThreads", llvm::cl::cat(statisticThreads));
+
+static llvm::cl::OptionCategory memReport("Reports the memory used by the analysis");
+static llvm::cl::extrahelp HelpMemReport("-memReport Use this flag, if you want to see how many nodes of each class were created, how much memory they use and the peak memory of each phase of the analysis. The report is also exported to Memory.csv and MemoryPhases.csv\n \n");
+static llvm::cl::opt<bool> MemReport("memReport", llvm::cl::cat(memReport));
 
 /**
- * @brief Tool entry point. The tool's entry point which calls the FrontEndAction on the code.
+ * @brief Collects the options of the analysis from the parsed command line.
+ */
+static AnalysisOptions GetAnalysisOptions(){
+	AnalysisOptions Options;
+	Options.OnlyPattern = OnlyPatterns.getValue();
+	Options.NoTree = NoTree.getValue();
+	Options.RelationTree = RelationTree.getValue();
+	Options.MaxTreeDisplayDepth = MaxTreeDisplayDepth.getValue();
+	Options.CompactTree = CompactTree.getValue();
+	Options.MaxTreeChildren = MaxTreeChildren.getValue();
+	Options.MergeCallSites = MergeCallSites.getValue();
+	Options.StopAtFirstError = StopAtFirstError.getValue();
+	Options.StatisticThreads = StatisticThreads.getValue();
+	return Options;
+}
+
+/**
+ * @brief Prints the call tree and, if requested, the relation tree.
+ */
+static void PrintTrees(AnalysisContext& Analysis){
+	const AnalysisOptions& Options = Analysis.GetOptions();
+	if(!Options.NoTree){
+		int mxdspldpth = Options.MaxTreeDisplayDepth;
+		if(Options.RelationTree){
+			CallTreeVisualisation::PrintRelationTree(mxdspldpth, &Analysis.GetGraph(), Options.OnlyPattern, Options.CompactTree, Options.MaxTreeChildren);
+			CallTreeVisualisation::PrintCallTree(mxdspldpth, &Analysis.GetCallTree(), Options.OnlyPattern, Options.CompactTree, Options.MaxTreeChildren);
+		}else{
+			CallTreeVisualisation::PrintCallTree(mxdspldpth, &Analysis.GetCallTree(), Options.OnlyPattern, Options.CompactTree, Options.MaxTreeChildren);
+		}
+	}
+}
+
+/**
+ * @brief Calculates and prints all statistics and similarity measures and exports the statistics as CSV files.
  * Register statistics and similarity measures here.
+ * The calculations are tasks of a StatisticScheduler, which runs them on -statisticThreads threads. The results are printed
+ * afterwards in the order of registration, so the output does not depend on the number of threads.
+ * With -memReport every statistic and similarity measure is a phase of the memory report, so the calculations run serially.
+ */
+static void PrintStatistics(AnalysisContext& Analysis, MemoryReport& Report){
+	PatternGraph* Graph = &Analysis.GetGraph();
+
+	SimplePatternCountStatistic Counts(Graph);
+	FanInFanOutStatistic FanInFanOut(Graph, 20);
+	LinesOfCodeStatistic LinesOfCode(Graph);
+	CyclomaticComplexityStatistic CyclomaticComplexity(Graph);
+	FunctionPointAnalysisStatistic FunctionPointAnalysis(Graph);
+	CohesionStatistic Cohesion(Graph);
+	HalsteadStatistic Halstead(Graph);
+
+	HPCPatternStatistic* Statistics[] = {
+			&Counts,
+			&FanInFanOut,
+			&LinesOfCode,
+			&CyclomaticComplexity,
+			&FunctionPointAnalysis,
+			&Cohesion,
+			&Halstead
+	};
+
+	const char* StatisticNames[] = {"Counts", "FIFO", "LOC", "CC", "FPA", "Cohesion", "Halstead"};
+
+	/* The statistics that can be split into parts of the patterns */
+	PerPatternStatistic* PerPatternStatistics[] = {NULL, NULL, NULL, NULL, &FunctionPointAnalysis, &Cohesion, &Halstead};
+
+	StatisticScheduler Scheduler(Report.IsEnabled() ? 1 : Analysis.GetOptions().StatisticThreads);
+
+	/* Wraps a calculation into a phase of the memory report, which is only enabled for a serial run */
+	auto Phase = [&Report](const char* Name, std::function<void()> Work){
+		return [&Report, Name, Work](){
+			Report.BeginPhase(Name);
+			Work();
+			Report.EndPhase();
+		};
+	};
+
+	/* The statistics freeze the graph on first use, which must not happen while others read it */
+	StatisticScheduler::TaskID Freeze = Scheduler.AddTask([Graph](){
+		if(Graph->GetSnapshot() == NULL){
+			Graph->Freeze();
+		}
+	});
+
+	for (size_t i = 0; i < sizeof(Statistics) / sizeof(Statistics[0]); i++){
+		if(PerPatternStatistics[i] != NULL && Scheduler.GetNumThreads() > 1){
+			Scheduler.AddPerPatternStatistic(PerPatternStatistics[i], {Freeze});
+		}else{
+			HPCPatternStatistic* Statistic = Statistics[i];
+			Scheduler.AddTask(Phase(StatisticNames[i], [Statistic](){ Statistic->Calculate(); }), {Freeze});
+		}
+	}
+
+	// Similarity Measures
+	PatternGraphNode* RootNode = Graph -> GetRootNode();
+
+	std::unique_ptr<JaccardSimilarityStatistic> Jaccard;
+	std::unique_ptr<WeightedJaccardSimilarityStatistic> WeightedJaccard;
+	std::unique_ptr<OverlapCoefficientStatistic> Overlap;
+	std::unique_ptr<CosineSimilarityStatistic> Cosine;
+
+	Scheduler.AddTask(Phase("Jaccard", [&](){
+		Jaccard.reset(new JaccardSimilarityStatistic(Graph, RootNode, GraphSearchDirection::DIR_Parents, SimilarityCriterion::Pattern));
+		Jaccard->Calculate();
+	}), {Freeze});
+
+	Scheduler.AddTask(Phase("WeightedJaccard", [&](){
+		WeightedJaccard.reset(new WeightedJaccardSimilarityStatistic(Graph, RootNode, GraphSearchDirection::DIR_Parents, SimilarityCriterion::Pattern));
+		WeightedJaccard->Calculate();
+	}), {Freeze});
+
+	Scheduler.AddTask(Phase("Overlap", [&](){
+		Overlap.reset(new OverlapCoefficientStatistic(Graph, RootNode, GraphSearchDirection::DIR_Parents, SimilarityCriterion::Pattern));
+		Overlap->Calculate();
+	}), {Freeze});
+
+	Scheduler.AddTask(Phase("Cosine", [&](){
+		Cosine.reset(new CosineSimilarityStatistic(Graph, RootNode, GraphSearchDirection::DIR_Parents, SimilarityCriterion::Pattern));
+		Cosine->Calculate();
+	}), {Freeze});
+
+	Scheduler.Run();
+
+	for (size_t i = 0; i < sizeof(Statistics) / sizeof(Statistics[0]); i++){
+		std::cout << std::endl << std::endl;
+		Statistics[i]->Print();
+	}
+
+	Statistics[0]->CSVExport("Counts.csv");
+	Statistics[1]->CSVExport("FIFO.csv");
+	Statistics[2]->CSVExport("LOC.csv");
+	Statistics[3]->CSVExport("CC.csv");
+	Statistics[4]->CSVExport("FPA.csv");
+	Statistics[5]->CSVExport("Cohesion.csv");
+	Statistics[6]->CSVExport("Halstead.csv");
+
+	Report.RecordSimilarityPairs("Jaccard", *Jaccard);
+	Jaccard->Print();
+
+	Report.RecordSimilarityPairs("WeightedJaccard", *WeightedJaccard);
+	WeightedJaccard->Print();
+
+	Report.RecordSimilarityPairs("Overlap", *Overlap);
+	Overlap->Print();
+
+	Report.RecordSimilarityPairs("Cosine", *Cosine);
+	Cosine->Print();
+}
+
+/**
+ * @brief Prints and exports the memory report, if it has been requested with -memReport.
+ * Has to be called before the nodes of the analysis are released.
+ */
+static void PrintMemoryReport(AnalysisContext& Analysis, MemoryReport& Report){
+	if(!Report.IsEnabled()){
+		return;
+	}
+
+	std::cout << std::endl << std::endl;
+	Report.RecordArena(Analysis.GetGraph().GetArena());
+	Report.Print();
+	Report.CSVExport("Memory.csv");
+	Report.CSVExportPhases("MemoryPhases.csv");
+}
+
+/**
+ * @brief Tool entry point. The tool's entry point which calls the FrontEndAction on the code.
+ * The state of the analysis is owned by the AnalysisContext created here.
  */
 
 int main (int argc, const char** argv){
-	setCommandArguments(
-			OnlyPatterns.getValue(),
-			NoTree.getValue(),
-			UseSpecFiles.getValue(),
-			MaxTreeDisplayDepth.getValue(),
-			DisplayCompilationsList.getValue(),
-			PintVersion.getValue(),
-			RelationTree.getValue()
-	);
-
-	MaxTreeDisplayDepth.setInitialValue(MAX_DEPTH);
+	MaxTreeDisplayDepth.setInitialValue(AnalysisOptions().MaxTreeDisplayDepth);
 
 	clang::tooling::CommonOptionsParser OptsParserVersion(argc, argv, pintVersion);
 
+	AnalysisContext Analysis(GetAnalysisOptions());
+	MemoryReport Report(MemReport.getValue());
+
 	if(PintVersion.getValue()){
 		std::cout << "You are currently using the Version: " << PInTVersion <<'\n';
+	}else if(!LoadGraph.getValue().empty()){
+		/* Everything that depends on clang was done when the graph was saved */
+		Report.BeginPhase("load");
+		try{
+			PatternGraphFile::Load(Analysis, LoadGraph.getValue());
+		}catch(GraphFileException& e){
+			std::cout << e.what();
+			return 1;
+		}
+		Analysis.GetGraph().Freeze();
+		Report.EndPhase();
+
+		PrintTrees(Analysis);
+		PrintStatistics(Analysis, Report);
+		PrintMemoryReport(Analysis, Report);
+
+		Analysis.Clear();
+
+		return 0;
 	}else{
 		clang::tooling::CommonOptionsParser OptsParser(argc, argv, HPCPatternToolCategory);
 		std::vector<std::string> analyseList;
@@ -174,15 +376,24 @@ int main (int argc, const char** argv){
 		/* Run the tool with options and source files provided */
 		int retcode = 0;
 		try{
-			retcode = HPCPatternTool.run(clang::tooling::newFrontendActionFactory<ASTFrontendInstrumentationAction>().get());
+			AnalysisActionFactory<ASTFrontendInstrumentationAction> InstrumentationFactory(&Analysis);
+			Report.BeginPhase("parse");
+			retcode = HPCPatternTool.run(&InstrumentationFactory);
+			Report.EndPhase();
+
+			/* Linking and setting up the call tree is pointless with unpaired instrumentation calls */
+			PatternPairingValidator& Pairing = Analysis.GetPairingValidator();
+			if(!Pairing.Finish()){
+				std::cout << Pairing.GetNumErrors() << " Pattern_Begin or Pattern_End calls are not paired." << std::endl;
+				throw TerminateEarlyException();
+			}
 
 			#ifdef DEBUG
 				std::cout << "\nPrinting out DeclarationVector: " << std::endl;
-				for(CallTreeNode* Node : *ClTre->GetDeclarationVector()){
+				for(CallTreeNode* Node : *Analysis.GetCallTree().GetDeclarationVector()){
 					std::cout << *Node->GetID() << " " << Node->GetNodeType()<< std::endl;
-					for(auto CalleeEntry = (Node->GetCallees())->begin() ; CalleeEntry != (Node->GetCallees())->end();){
-						std::cout << "--> " << *(CalleeEntry->second)->GetID() << " " << (CalleeEntry->second)->GetNodeType()<< std::endl;
-						CalleeEntry++;
+					for(CallTreeNode* Callee : *Node->GetCallees()){
+						std::cout << "--> " << *Callee->GetID() << " " << Callee->GetNodeType()<< std::endl;
 					}
 				}
 			#endif
@@ -191,58 +402,45 @@ int main (int argc, const char** argv){
 			return 0;
 		}
 		try{
-			ClTre->appendAllDeclToCallTree(ClTre->getRoot(), MAX_DEPTH);
-			ClTre->setUpTree();
-			ClTre->lookIfTreeIsCorrect();
+			CallTree& ClTre = Analysis.GetCallTree();
+			Report.BeginPhase("compose");
+			PatternTransferComposition(&Analysis.GetGraph()).Compose();
+			Report.BeginPhase("link");
+			ClTre.appendAllDeclToCallTree(ClTre.getRoot());
+			Report.BeginPhase("setUpTree");
+			ClTre.setUpTree();
+			Report.EndPhase();
 		}catch(TooManyBeginsException& begins){
 			begins.what();
 			return 0;
 		}
-		if(!NoTree.getValue()){
-			int mxdspldpth = MaxTreeDisplayDepth.getValue();
-			if(RelationTree.getValue()){
-				CallTreeVisualisation::PrintRelationTree(mxdspldpth, OnlyPatterns.getValue());
-				CallTreeVisualisation::PrintCallTree(mxdspldpth, ClTre, OnlyPatterns.getValue());
-			}else{
-				CallTreeVisualisation::PrintCallTree(mxdspldpth, ClTre, OnlyPatterns.getValue());
-			}
-		}
+		// The graph is complete, all following steps only read it
+		Report.BeginPhase("freeze");
+		Analysis.GetGraph().Freeze();
+		Report.EndPhase();
 
-		//Has to be done after the pattern graph was constructed
-		HPCPatternTool.run(clang::tooling::newFrontendActionFactory<ASTFrontendDelegatorAction>().get());
+		PrintTrees(Analysis);
 
-		for (HPCPatternStatistic* Stat : Statistics){
-			std::cout << std::endl << std::endl;
-			Stat->Calculate();
-			Stat->Print();
+		//Has to be done after the pattern graph was constructed
+		AnalysisActionFactory<ASTFrontendDelegatorAction> DelegatorFactory(&Analysis);
+		Report.BeginPhase("metrics");
+		HPCPatternTool.run(&DelegatorFactory);
+		Report.EndPhase();
+
+		if(!SaveGraph.getValue().empty()){
+			try{
+				PatternGraphFile::Save(Analysis, SaveGraph.getValue());
+			}catch(GraphFileException& e){
+				std::cout << e.what();
+				return 1;
+			}
 		}
 
-		Statistics[0]->CSVExport("Counts.csv");
-		Statistics[1]->CSVExport("FIFO.csv");
-		Statistics[2]->CSVExport("LOC.csv");
-		Statistics[3]->CSVExport("CC.csv");
-		Statistics[4]->CSVExport("FPA.csv");
-		Statistics[5]->CSVExport("Cohesion.csv");
-		Statistics[6]->CSVExport("Halstead.csv");
-
-		// Similarity Measures
-		PatternGraphNode* RootNode = PatternGraph::GetInstance() -> GetRootNode();
-
-		JaccardSimilarityStatistic Jaccard(RootNode, GraphSearchDirection::DIR_Parents, SimilarityCriterion::Pattern);
-		Jaccard.Calculate();
-		Jaccard.Print();
-
-		WeightedJaccardSimilarityStatistic WeightedJaccard(RootNode, GraphSearchDirection::DIR_Parents, SimilarityCriterion::Pattern);
-		WeightedJaccard.Calculate();
-		WeightedJaccard.Print();
-
-		OverlapCoefficientStatistic Overlap(RootNode, GraphSearchDirection::DIR_Parents, SimilarityCriterion::Pattern);
-		Overlap.Calculate();
-		Overlap.Print();
+		PrintStatistics(Analysis, Report);
+		PrintMemoryReport(Analysis, Report);
 
-		CosineSimilarityStatistic Cosine(RootNode, GraphSearchDirection::DIR_Parents, SimilarityCriterion::Pattern);
-		Cosine.Calculate();
-		Cosine.Print();
+		// Release all nodes of the analysis at once
+		Analysis.Clear();
 
 		return retcode;
 	}
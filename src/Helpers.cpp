@@ -1,7 +1,10 @@
 #include "Helpers.h"
 #include "HPCPatternStatistics.h"
+#include "visitor/DepthFirstTraversal.h"
 #include <sstream>
 #include <cstdarg>
+#include <limits>
+#include <unordered_set>
 
 /**
  * @brief A helper function to retrieve all PatternOccurrence objects from a list of PatternCodeRegions.
@@ -31,66 +34,48 @@ std::vector<PatternOccurrence*> PatternHelpers::GetPatternOccurrences(std::vecto
 	return PatternOccurrences;
 }
 
-void GraphAlgorithms::FindAllParentPatternCodeRegions(PatternCodeRegion* Start, std::vector<PatternCodeRegion*>& Parents){
-	class ParentVisitor : public PatternGraphNodeVisitor{
-		public:
-			std::vector<PatternCodeRegion*> CodeRegions;
-			void HandlePatternCodeRegion(PatternCodeRegion* Node) override{
-				CodeRegions.push_back(Node);
-
-				for(PatternGraphNode* Parent : Node -> GetParents())
-					Parent -> Accept(this);
-			}
-			//void HandleFunctionNode(FunctionNode* Node) override{}
-	};
-
-	ParentVisitor Visitor;
-	Start -> Accept(&Visitor);
-	Parents.insert(Parents.end(), Visitor.CodeRegions.begin(), Visitor.CodeRegions.end());
-}
-
 /**
- * @brief A tree operation that marks every tree node with the label corresponding to its connected component.
- * Calls GraphAlgorithms::MarkConnectedComponents(PatternGraphNode*, int).
+ * Collects a code region and its parents. Like the visitor it replaces, a function node on the way
+ * is entered once and continues the search with its children.
  */
-void GraphAlgorithms::MarkConnectedComponents()
+class ParentCodeRegionSearch : public DepthFirstTraversal<ParentCodeRegionSearch, PatternGraphNode*>
 {
-	std::vector<PatternCodeRegion*> PatternCodeRegs = PatternGraph::GetInstance()->GetAllPatternCodeRegions();
+public:
+	std::vector<PatternCodeRegion*> CodeRegions;
 
-	int ConnectedComponents = 0;
-
-	for (PatternCodeRegion* PatternCodeReg : PatternCodeRegs)
+	bool PreVisit(PatternGraphNode* Node, int Depth)
 	{
-		if (PatternCodeReg->GetConnectedComponent() == -1)
+		static_cast<void>(Depth); //Avoid unused parameter warning
+
+		if (PatternCodeRegion* CodeRegion = clang::dyn_cast<PatternCodeRegion>(Node))
 		{
-			MarkConnectedComponents(PatternCodeReg, ConnectedComponents);
-			ConnectedComponents++;
+			CodeRegions.push_back(CodeRegion);
+			return true;
 		}
+
+		/* VisitedNodes.insert returns true if it's the first time the function is reached */
+		FunctionNode* Function = clang::dyn_cast<FunctionNode>(Node);
+		return Function != NULL && VisitedNodes.insert(Function->GetHash()).second;
 	}
-}
 
-/**
- * @brief Marks every tree node with label corresponding to connected component
- *
- * @param Node The current node.
- * @param ComponentID ID of the connected component.
- **/
-void GraphAlgorithms::MarkConnectedComponents(PatternGraphNode* Node, int ComponentID)
-{
-	if (Node->GetConnectedComponent() == -1)
+	size_t GetNumNeighbours(PatternGraphNode* Node)
 	{
-		Node->SetConnectedComponent(ComponentID);
-
-		for (PatternGraphNode* Child : Node->GetChildren())
-		{
-			MarkConnectedComponents(Child, ComponentID);
-		}
+		return clang::isa<PatternCodeRegion>(Node) ? Node->GetParents().size() : Node->GetChildren().size();
+	}
 
-		for (PatternGraphNode* Parent : Node->GetParents())
-		{
-			MarkConnectedComponents(Parent, ComponentID);
-		}
+	PatternGraphNode* GetNeighbour(PatternGraphNode* Node, size_t Index)
+	{
+		return clang::isa<PatternCodeRegion>(Node) ? Node->GetParents()[Index] : Node->GetChildren()[Index];
 	}
+
+private:
+	std::unordered_set<uint64_t> VisitedNodes;
+};
+
+void GraphAlgorithms::FindAllParentPatternCodeRegions(PatternCodeRegion* Start, std::vector<PatternCodeRegion*>& Parents){
+	ParentCodeRegionSearch Search;
+	Search.Traverse(Start);
+	Parents.insert(Parents.end(), Search.CodeRegions.begin(), Search.CodeRegions.end());
 }
 
 /**
@@ -119,96 +104,100 @@ void GraphAlgorithms::FindChildPatternCodeRegions(PatternCodeRegion* Start, std:
 }
 
 /**
- * @brief Core functionality for finding neightbouring PatternCodeRegions of a PatternGraphNode (in this case: PatternCodeRegion).
- * The direction of the recursive descent is passed as a parameter.
+ * Collects the closest PatternCodeRegions in one direction. A code region other than the start is a result
+ * and is not expanded. Neighbours are only followed if the first one is valid.
  *
- * @param Current The starting point of the recursive descent.
- * @param Results Vector of PatternCodeRegion neighbours.
- * @param dir The search direction (Children or parents)
- * @param depth The current depth of recursion.
- * @param maxdepth The maximum recursion depth.
- **/
-void GraphAlgorithms::FindNeighbourPatternCodeRegions(PatternGraphNode* Current, std::vector<PatternCodeRegion*>& Results, GraphSearchDirection dir, int depth, int maxdepth)
+ * If a shared counter is given, it is increased for every node besides the start and replaces the depth
+ * in the comparison with the maximum depth, as in GraphAlgorithms::FindNeighbourPatternCodeRegionss().
+ */
+class NeighbourCodeRegionSearch : public DepthFirstTraversal<NeighbourCodeRegionSearch, PatternGraphNode*>
 {
-	/* Check, if we reached the maximum depth */
-	if (depth >= maxdepth)
+public:
+	NeighbourCodeRegionSearch(std::vector<PatternCodeRegion*>& myResults, GraphSearchDirection myDir, int* myCounter, int maxdepth) :
+		DepthFirstTraversal(myCounter == NULL ? maxdepth - 1 : std::numeric_limits<int>::max()),
+		Results(myResults), Dir(myDir), Counter(myCounter), MaxCount(maxdepth)
 	{
-		return;
-	}
-
-	PatternCodeRegion* PatternReg = clang::dyn_cast<PatternCodeRegion>(Current);
 
-	if (depth > 0 && PatternReg != NULL)
-	{
-		Results.push_back(PatternReg);
 	}
-	else
-	{
-		/* Get the neighbouring nodes depending on the defined search direction */
-		std::vector<PatternGraphNode*> Neighbours;
 
-		if (dir == DIR_Parents)
+	bool PreVisit(PatternGraphNode* Node, int Depth)
+	{
+		if (Counter != NULL)
 		{
-			Neighbours = Current->GetParents();
+			if (Depth > 0)
+			{
+				*Counter = *Counter + 1;
+			}
+
+			/* Check, if we reached the maximum depth */
+			if (*Counter >= MaxCount)
+			{
+				return false;
+			}
+
+			Depth = *Counter;
 		}
-		else if (dir == DIR_Children)
+
+		PatternCodeRegion* PatternReg = clang::dyn_cast<PatternCodeRegion>(Node);
+
+		if (Depth > 0 && PatternReg != NULL)
 		{
-			Neighbours = Current->GetChildren();
+			Results.push_back(PatternReg);
+			return false;
 		}
 
+		return true;
+	}
 
+	size_t GetNumNeighbours(PatternGraphNode* Node)
+	{
+		const std::vector<PatternGraphNode*>& Neighbours = GetNeighbours(Node);
 
-		/* Visit all the neighbouring nodes according to the given direction */
-		if (Neighbours.size() > 0 && Neighbours[0] != NULL && Neighbours[0] != 0){
-			for (PatternGraphNode* Neighbour : Neighbours)
-			{
-				FindNeighbourPatternCodeRegions(Neighbour, Results, dir, depth + 1, maxdepth);
-			}
+		if (Neighbours.empty() || Neighbours[0] == NULL)
+		{
+			return 0;
 		}
+
+		return Neighbours.size();
 	}
-		return;
-}
 
-void GraphAlgorithms::FindNeighbourPatternCodeRegionss(PatternGraphNode* Current, std::vector<PatternCodeRegion*>& Results, GraphSearchDirection dir, int* depth, int maxdepth)
-{
-	/* Check, if we reached the maximum depth */
-	if (*depth >= maxdepth)
+	PatternGraphNode* GetNeighbour(PatternGraphNode* Node, size_t Index)
 	{
-		return;
+		return GetNeighbours(Node)[Index];
 	}
 
-	PatternCodeRegion* PatternReg = clang::dyn_cast<PatternCodeRegion>(Current);
-
-	if (*depth > 0 && PatternReg != NULL)
+private:
+	const std::vector<PatternGraphNode*>& GetNeighbours(PatternGraphNode* Node)
 	{
-		Results.push_back(PatternReg);
+		return Dir == DIR_Parents ? Node->GetParents() : Node->GetChildren();
 	}
-	else
-	{
-		/* Get the neighbouring nodes depending on the defined search direction */
-		std::vector<PatternGraphNode*> Neighbours;
-
-		if (dir == DIR_Parents)
-		{
-			Neighbours = Current->GetParents();
-		}
-		else if (dir == DIR_Children)
-		{
-			Neighbours = Current->GetChildren();
-		}
 
+	std::vector<PatternCodeRegion*>& Results;
+	GraphSearchDirection Dir;
+	int* Counter;
+	int MaxCount;
+};
 
+/**
+ * @brief Core functionality for finding neightbouring PatternCodeRegions of a PatternGraphNode (in this case: PatternCodeRegion).
+ * The direction of the descent is passed as a parameter.
+ *
+ * @param Current The starting point of the descent.
+ * @param Results Vector of PatternCodeRegion neighbours.
+ * @param dir The search direction (Children or parents)
+ * @param depth The depth of the starting point.
+ * @param maxdepth The maximum depth.
+ **/
+void GraphAlgorithms::FindNeighbourPatternCodeRegions(PatternGraphNode* Current, std::vector<PatternCodeRegion*>& Results, GraphSearchDirection dir, int depth, int maxdepth)
+{
+	NeighbourCodeRegionSearch Search(Results, dir, NULL, maxdepth);
+	Search.Traverse(Current, depth);
+}
 
-		/* Visit all the neighbouring nodes according to the given direction */
-		if (Neighbours.size() > 0 && Neighbours[0] != NULL && Neighbours[0] != 0){
-			for (PatternGraphNode* Neighbour : Neighbours)
-			{
-				*depth = *depth + 1;
-				FindNeighbourPatternCodeRegionss(Neighbour, Results, dir, depth , maxdepth);
-			}
-		}
-	}
-		return;
+void GraphAlgorithms::FindNeighbourPatternCodeRegionss(PatternGraphNode* Current, std::vector<PatternCodeRegion*>& Results, GraphSearchDirection dir, int* depth, int maxdepth)
+{
+	NeighbourCodeRegionSearch Search(Results, dir, depth, maxdepth);
+	Search.Traverse(Current, 0);
 }
 
 /**
@@ -281,9 +270,3 @@ std::vector<HPCParallelPattern*> SetAlgorithms::GetUniquePatternList(std::vector
 	return Res;
 }
 
-void Preconditions::CheckArgument(bool Condition, std::exception Exception){
-	if(!Condition){
-		std::cerr << Exception.what() << std::endl;
-		throw Exception;
-	}
-}
@@ -0,0 +1,238 @@
+#include "MemoryReport.h"
+
+#include "AnalysisArena.h"
+#include "PatternGraph.h"
+#include "HPCParallelPattern.h"
+#include "Helpers.h"
+#include "SimilarityMetrics.h"
+#include "metric/fpa/ExternalInput.h"
+#include "metric/fpa/ExternalOutput.h"
+#include "metric/fpa/ExternalInquiry.h"
+#include "metric/fpa/InternalLogicalFile.h"
+#include "metric/fpa/ExternalInterfaceFile.h"
+
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
+
+MemoryReport::MemoryReport(bool myEnabled) : Enabled(myEnabled)
+{
+
+}
+
+void MemoryReport::BeginPhase(const std::string& Name)
+{
+	if (!Enabled)
+	{
+		return;
+	}
+
+	if (!CurrentPhase.empty())
+	{
+		EndPhase();
+	}
+
+	CurrentPhase = Name;
+	CurrentPhaseCumulative = !ResetPeakRSS();
+}
+
+void MemoryReport::EndPhase()
+{
+	if (!Enabled || CurrentPhase.empty())
+	{
+		return;
+	}
+
+	Phases.push_back(PhaseUsage{CurrentPhase, ReadPeakRSS(), CurrentPhaseCumulative});
+	CurrentPhase.clear();
+}
+
+template<typename T>
+void MemoryReport::AddObjects(AnalysisArena& Arena, const std::string& Class)
+{
+	size_t Count = Arena.GetNumberOfObjects<T>();
+	Objects.push_back(ObjectCount{Class, Count, Count * sizeof(T)});
+}
+
+void MemoryReport::RecordArena(AnalysisArena& Arena)
+{
+	if (!Enabled)
+	{
+		return;
+	}
+
+	Objects.clear();
+
+	AddObjects<FunctionNode>(Arena, "FunctionNode");
+	AddObjects<HPCParallelPattern>(Arena, "HPCParallelPattern");
+	AddObjects<PatternOccurrence>(Arena, "PatternOccurrence");
+	AddObjects<PatternCodeRegion>(Arena, "PatternCodeRegion");
+	AddObjects<CallTreeNode>(Arena, "CallTreeNode");
+	AddObjects<Identification>(Arena, "Identification");
+	AddObjects<ExternalInput>(Arena, "FunctionPoint (ExternalInput)");
+	AddObjects<ExternalOutput>(Arena, "FunctionPoint (ExternalOutput)");
+	AddObjects<ExternalInquiry>(Arena, "FunctionPoint (ExternalInquiry)");
+	AddObjects<InternalLogicalFile>(Arena, "FunctionPoint (InternalLogicalFile)");
+	AddObjects<ExternalInterfaceFile>(Arena, "FunctionPoint (ExternalInterfaceFile)");
+}
+
+void MemoryReport::RecordSimilarityPairs(const std::string& Label, SimilarityMeasure& Measure)
+{
+	if (!Enabled)
+	{
+		return;
+	}
+
+	/* Each pair is allocated on its own and referenced by a pointer in the similarity matrix */
+	size_t Count = Measure.GetNumberOfSimilarityPairs();
+	SimilarityPairs.push_back(ObjectCount{"SimilarityPair (" + Label + ")", Count, Count * (sizeof(SimilarityPair) + sizeof(SimilarityPairPointer))});
+}
+
+/**
+ * @brief Formats a number of bytes in MiB.
+ *
+ * @param Bytes The number of bytes.
+ *
+ * @return The formatted string.
+ **/
+static std::string FormatBytes(size_t Bytes)
+{
+	std::ostringstream Stream;
+	Stream << std::fixed << std::setprecision(1) << Bytes / (1024.0 * 1024.0) << " MiB";
+	return Stream.str();
+}
+
+void MemoryReport::Print()
+{
+	if (!Enabled)
+	{
+		return;
+	}
+
+	EndPhase();
+
+	std::cout << "\033[33m" << "MEMORY REPORT" << "\033[0m" << std::endl;
+
+	size_t TotalBytes = 0;
+
+	for (const std::vector<ObjectCount>* Counts : {&Objects, &SimilarityPairs})
+	{
+		for (const ObjectCount& Entry : *Counts)
+		{
+			std::cout << Entry.Class << ": " << Entry.Count << " objects, " << FormatBytes(Entry.Bytes) << std::endl;
+			TotalBytes += Entry.Bytes;
+		}
+	}
+
+	std::cout << "Total: " << FormatBytes(TotalBytes) << std::endl << std::endl;
+
+	for (const PhaseUsage& Phase : Phases)
+	{
+		std::cout << "Peak RSS during " << Phase.Name << ": " << FormatBytes(Phase.PeakRSS);
+
+		if (Phase.Cumulative)
+		{
+			std::cout << " (since the start of the tool)";
+		}
+
+		std::cout << std::endl;
+	}
+}
+
+void MemoryReport::CSVExport(std::string FileName)
+{
+	if (!Enabled)
+	{
+		return;
+	}
+
+	std::ofstream File;
+	File.open(FileName, std::ios::app);
+
+	File << IO::CSVPrintLine("Class", "Count", "Bytes");
+
+	for (const std::vector<ObjectCount>* Counts : {&Objects, &SimilarityPairs})
+	{
+		for (const ObjectCount& Entry : *Counts)
+		{
+			File << IO::CSVPrintLine(Entry.Class, Entry.Count, Entry.Bytes);
+		}
+	}
+
+	File.close();
+}
+
+void MemoryReport::CSVExportPhases(std::string FileName)
+{
+	if (!Enabled)
+	{
+		return;
+	}
+
+	EndPhase();
+
+	std::ofstream File;
+	File.open(FileName, std::ios::app);
+
+	File << IO::CSVPrintLine("Phase", "PeakRSS", "Cumulative");
+
+	for (const PhaseUsage& Phase : Phases)
+	{
+		File << IO::CSVPrintLine(Phase.Name, Phase.PeakRSS, Phase.Cumulative);
+	}
+
+	File.close();
+}
+
+bool MemoryReport::ResetPeakRSS()
+{
+	/* Writing 5 to clear_refs resets the peak to the current resident set size (Linux 4.0 and later) */
+	std::ofstream ClearRefs("/proc/self/clear_refs");
+
+	if (!ClearRefs)
+	{
+		return false;
+	}
+
+	ClearRefs << "5";
+	ClearRefs.close();
+
+	return ClearRefs.good();
+}
+
+size_t MemoryReport::ReadPeakRSS()
+{
+	std::ifstream Status("/proc/self/status");
+	std::string Line;
+
+	while (std::getline(Status, Line))
+	{
+		if (Line.compare(0, 6, "VmHWM:") == 0)
+		{
+			return std::stoul(Line.substr(6)) * 1024;
+		}
+	}
+
+#if defined(__APPLE__)
+	struct rusage Usage;
+	if (getrusage(RUSAGE_SELF, &Usage) == 0)
+	{
+		/* Bytes on macOS */
+		return Usage.ru_maxrss;
+	}
+#elif defined(__unix__)
+	struct rusage Usage;
+	if (getrusage(RUSAGE_SELF, &Usage) == 0)
+	{
+		/* Kilobytes on Linux */
+		return Usage.ru_maxrss * 1024;
+	}
+#endif
+
+	return 0;
+}
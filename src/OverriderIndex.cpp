@@ -0,0 +1,47 @@
+#include "OverriderIndex.h"
+
+#include <algorithm>
+
+void OverriderIndex::AddOverrider(FunctionID Overridden, FunctionID Overrider)
+{
+	std::vector<FunctionID>& Direct = Overriders[Overridden];
+
+	/* A method has only a few direct overriders, but may be defined in several translation units */
+	if (std::find(Direct.begin(), Direct.end(), Overrider) == Direct.end())
+	{
+		Direct.push_back(Overrider);
+	}
+}
+
+void OverriderIndex::GetDispatchCandidates(FunctionID Method, std::vector<FunctionID>& Candidates) const
+{
+	std::unordered_set<FunctionID> Visited;
+	std::vector<FunctionID> Stack;
+
+	Visited.insert(Method);
+	Stack.push_back(Method);
+
+	/* With multiple inheritance, an overrider may be reached on several paths */
+	while (!Stack.empty())
+	{
+		FunctionID Current = Stack.back();
+		Stack.pop_back();
+		Candidates.push_back(Current);
+
+		auto Entry = Overriders.find(Current);
+
+		if (Entry == Overriders.end())
+		{
+			continue;
+		}
+
+		/* Pushed in reverse, so the first overrider is visited first */
+		for (std::vector<FunctionID>::const_reverse_iterator Overrider = Entry->second.rbegin(); Overrider != Entry->second.rend(); Overrider++)
+		{
+			if (Visited.insert(*Overrider).second)
+			{
+				Stack.push_back(*Overrider);
+			}
+		}
+	}
+}
@@ -2,9 +2,14 @@
 
 #include "HPCParallelPattern.h"
 #include "HPCError.h"
+#include "CallTreeLinker.h"
+#include "PatternNestingMatcher.h"
 
 #include <iostream>
 #include "clang/AST/ODRHash.h"
+#include "clang/Index/USRGeneration.h"
+#include "llvm/ADT/SmallString.h"
+#include "llvm/Support/xxhash.h"
 
 #define SUITEDFORSTATSDEBUG
 //#define TEST
@@ -13,34 +18,41 @@
 /*
  * Function Declaration Database Entry functions
  */
-FunctionNode::FunctionNode (std::string Name, unsigned Hash) : PatternGraphNode(GNK_FnCall), Children(), Parents()
+FunctionNode::FunctionNode (std::string Name, FunctionID Hash) : PatternGraphNode(GNK_FnCall), Children(), Parents()
 {
 	this->FnName = Name;
 	this->Hash = Hash;
 }
 
+const void* PatternGraphNode::GetEdgeKey()
+{
+	if (PatternCodeRegion* CodeReg = clang::dyn_cast<PatternCodeRegion>(this))
+	{
+		return CodeReg->GetPatternOccurrence();
+	}
+
+	return this;
+}
+
 void FunctionNode::Accept(PatternGraphNodeVisitor* Visitor){
     Visitor -> HandleFunctionNode(this);
 }
 
 void FunctionNode::AddChild(PatternGraphNode* Child)
 {
-	Children.push_back(Child);
+	Children.Insert(Child, Child);
 }
 
 void FunctionNode::AddParent(PatternGraphNode* Parent)
 {
-	Parents.push_back(Parent);
+	Parents.Insert(Parent, Parent);
 }
 
 void FunctionNode::AddPatternParent(PatternGraphNode* PatParent)
-{/*Before we add a parent we look if this parent has not been registered already
+{/*A parent with the same identifier is only registered once
 	*/
 	PatternCodeRegion* PatternParent = clang::dyn_cast<PatternCodeRegion>(PatParent);
-	for(PatternCodeRegion* PatRegFor : this->PatternParents){
-		if(PatRegFor->GetID() == PatternParent->GetID()) return;
-	}
-	this->PatternParents.push_back(PatternParent);
+	this->PatternParents.Insert(PatternParent, PatternParent->GetEdgeKey());
 }
 
 void FunctionNode::AddPatternParents(std::vector<PatternCodeRegion*> PatternParents){
@@ -50,34 +62,31 @@ void FunctionNode::AddPatternParents(std::vector<PatternCodeRegion*> PatternPare
 }
 
 void FunctionNode::AddPatternChild(PatternGraphNode* PatChild)
-{/*Before we add a child we look if this child has not been registered already
+{/*A child with the same identifier is only registered once
 	*/
 	PatternCodeRegion* PatternChild = clang::dyn_cast<PatternCodeRegion>(PatChild);
-	for(PatternCodeRegion* PatRegFor : this->PatternChildren){
-		if(PatRegFor->GetID() == PatternChild->GetID()) return;
-	}
-	this->PatternChildren.push_back(PatternChild);
+	this->PatternChildren.Insert(PatternChild, PatternChild->GetEdgeKey());
 }
 
-std::vector<PatternCodeRegion*> FunctionNode::GetPatternParents()
+const std::vector<PatternCodeRegion*>& FunctionNode::GetPatternParents()
 {
-	return this->PatternParents;
+	return this->PatternParents.GetNodes();
 }
 
-std::vector<PatternCodeRegion*> FunctionNode::GetPatternChildren()
+const std::vector<PatternCodeRegion*>& FunctionNode::GetPatternChildren()
 {
-	return this->PatternChildren;
+	return this->PatternChildren.GetNodes();
 }
 
 bool FunctionNode::HasNoPatternParents(){
-	if(this->PatternParents.size()){
+	if(this->PatternParents.Size()){
 		return false;
 	}
 	return true;
 }
 
 bool FunctionNode::HasNoPatternChildren(){
-	if(this->PatternChildren.size()){
+	if(this->PatternChildren.Size()){
 		return false;
 	}
 	return true;
@@ -113,7 +122,7 @@ void FunctionNode::PrintVecOfPattern(std::vector<PatternCodeRegion*> RegionVec)
 		}
 }
 
-PatternGraph::PatternGraph() : Functions(), Patterns(), PatternOccurrences()
+PatternGraph::PatternGraph() : Functions(), Patterns(), PatternOccurrences(), RootNode(NULL)
 {
 
 }
@@ -134,26 +143,49 @@ std::vector<PatternGraphNode*> PatternGraph::GetOnlyPatternRootNodes(){
 		return this->OnlyPatternRootNodes;
 }
 
-FunctionNode* PatternGraph::GetFunctionNode(clang::FunctionDecl* Decl)
+FunctionID PatternGraph::CalculateFunctionID(const clang::FunctionDecl* Decl)
 {
-	clang::ODRHash Hash;
-	Hash.AddDecl(Decl);
-	unsigned HashVal = Hash.CalculateHash();
+	llvm::SmallString<128> USR;
+	FunctionID ID;
 
-	std::string FnName = Decl->getNameInfo().getName().getAsString();
+	/* generateUSRForDecl returns true if no USR could be generated */
+	if (!clang::index::generateUSRForDecl(Decl, USR))
+	{
+		ID = llvm::xxHash64(USR);
+	}
+	else
+	{
+		clang::ODRHash Hash;
+		Hash.AddDecl(Decl);
+		ID = llvm::xxHash64(Decl->getQualifiedNameAsString()) ^ ((FunctionID)Hash.CalculateHash() << 32);
+	}
+
+	/* 0 denotes identifications that do not belong to a function */
+	return ID != 0 ? ID : 1;
+}
 
-	// Search for an existing entry
-	for (FunctionNode* Func : Functions)
+FunctionNode* PatternGraph::GetFunctionNode(clang::FunctionDecl* Decl)
+{
+	auto Entry = FunctionsByHash.find(CalculateFunctionID(Decl));
+
+	if (Entry != FunctionsByHash.end())
 	{
-		if (Func->GetHash() == HashVal)
-		{
-			return Func;
-		}
+		return Entry->second;
 	}
 
 	return NULL;
 }
 
+void PatternGraph::RegisterOverrides(const clang::CXXMethodDecl* Method)
+{
+	FunctionID MethodID = CalculateFunctionID(Method);
+
+	for (const clang::CXXMethodDecl* Overridden : Method->overridden_methods())
+	{
+		Overriders.AddOverrider(CalculateFunctionID(Overridden), MethodID);
+		RegisterOverrides(Overridden);
+	}
+}
 
 void PatternGraph::RegisterOnlyPatternRootNode(PatternCodeRegion* CodeReg)
 {
@@ -162,23 +194,32 @@ void PatternGraph::RegisterOnlyPatternRootNode(PatternCodeRegion* CodeReg)
 
 bool PatternGraph::RegisterFunction(clang::FunctionDecl* Decl)
 {
-	if (GetFunctionNode(Decl) != NULL)
+	size_t NumFunctions = Functions.size();
+	GetOrRegisterFunction(Decl);
+
+	return Functions.size() != NumFunctions;
+}
+
+FunctionNode* PatternGraph::GetOrRegisterFunction(clang::FunctionDecl* Decl)
+{
+	FunctionID HashVal = CalculateFunctionID(Decl);
+
+	auto Entry = FunctionsByHash.insert({HashVal, NULL});
+
+	if (!Entry.second)
 	{
-		return false;
+		return Entry.first->second;
 	}
 
 	/* Extract information from the clang object */
-	clang::ODRHash Hash;
-	Hash.AddDecl(Decl);
-	unsigned HashVal = Hash.CalculateHash();
-
 	std::string FnName = Decl->getNameInfo().getName().getAsString();
 
 
 	/* Allocate a new entry */
 	FunctionNode* Func;
-	Func = new FunctionNode(FnName, HashVal);
+	Func = Arena.Create<FunctionNode>(FnName, HashVal);
 	Functions.push_back(Func);
+	Entry.first->second = Func;
 
 
 	/* Set as root node if this is the main function */
@@ -257,12 +298,25 @@ std::vector<PatternCodeRegion*> PatternGraph::GetAllPatternCodeRegions()
 	return CodeRegions;
 }
 
-CallTree* ClTre = new CallTree();
+void PatternGraph::Freeze()
+{
+	Snapshot.reset(new PatternGraphSnapshot(this));
+}
 
-Identification::~Identification()
+void PatternGraph::Clear()
 {
-	std::cout << "Identification of:" <<IdentificationString <<
-"or" << IdentificationUnsigned << "is deleted"<< '\n';
+	Snapshot.reset();
+
+	Functions.clear();
+	FunctionsByHash.clear();
+	Overriders.Clear();
+	Patterns.clear();
+	PatternOccurrences.clear();
+	RootNode = NULL;
+	OnlyPatternRootNodes.clear();
+
+	Arena.Reset();
+	FileTable.Clear();
 }
 
 Identification::Identification(){
@@ -276,24 +330,24 @@ Identification::Identification(CallTreeNodeType type, std::string identification
 	}
 }
 
-Identification::Identification(CallTreeNodeType type, unsigned identification)
+Identification::Identification(CallTreeNodeType type, FunctionID identification)
 {
 	if(type == Function || type == Function_Decl || type == Root){
-		this->IdentificationUnsigned = identification;
+		this->IdentificationHash = identification;
 	}
 }
 
 bool Identification::compare(Identification* ident)
 {
 	if(ident->IdentificationString.empty()){
-		return IdentificationUnsigned == ident->IdentificationUnsigned;
+		return IdentificationHash == ident->IdentificationHash;
 	}
 	return !IdentificationString.compare(ident->IdentificationString);
 }
 
-bool Identification::compare(unsigned Hash)
+bool Identification::compare(FunctionID Hash)
 {
-	return IdentificationUnsigned == Hash;
+	return IdentificationHash == Hash;
 }
 
 bool Identification::compare(std::string Id)
@@ -301,7 +355,7 @@ bool Identification::compare(std::string Id)
 	return !IdentificationString.compare(Id);
 }
 
-CallTree::CallTree()
+CallTree::CallTree(PatternGraph* Graph) : Graph(Graph)
 {
 		RootNode = NULL;
 }
@@ -309,9 +363,22 @@ CallTree::CallTree()
 CallTree::~CallTree(){
 }
 
+void CallTree::Clear()
+{
+	Pattern_EndVector.clear();
+	DeclarationVector.clear();
+	RootNode = NULL;
+	MergedCalls.clear();
+	MergedCallSiteLines.clear();
+	DeclarationsByID.clear();
+	PatternBeginsByID.clear();
+	NumIndexedDeclarations = 0;
+	Summaries.Clear();
+}
+
 CallTreeNode* CallTree::registerNode(CallTreeNodeType NodeType, PatternCodeRegion* PatCodeReg, CallTreeNodeType LastVisited, PatternCodeRegion* TopOfStack, FunctionNode* surroundingFunc)
 {
-	CallTreeNode* Node = new CallTreeNode(NodeType, PatCodeReg);
+	CallTreeNode* Node = Graph->GetArena().Create<CallTreeNode>(this, NodeType, PatCodeReg);
 	if(NodeType == Pattern_Begin || NodeType == Pattern_End)
 	{
 		if(LastVisited == Function_Decl)
@@ -348,31 +415,9 @@ CallTreeNode* CallTree::registerNode(CallTreeNodeType NodeType, PatternCodeRegio
 	return Node;
 }
 
-void CallTreeNode::Accept(CallTreeVisitor* Visitor){
-	switch(this -> GetNodeType()){
-		case Root:
-			Visitor -> HandleRoot(this);
-			break;
-		case Function_Decl:
-			Visitor -> HandleFunctionDeclaration(this);
-			break;
-		case Pattern_Begin:
-			Visitor -> HandlePatternBegin(this);
-			break;
-		case Pattern_End:
-			Visitor -> HandlePatternEnd(this);
-			break;
-		case Function:
-			Visitor -> HandleFunctionCall(this);
-			break;
-		default:
-			break;
-	}
-}
-
 CallTreeNode* CallTree::registerNode(CallTreeNodeType NodeType, FunctionNode* FuncNode, CallTreeNodeType LastVisited, PatternCodeRegion* TopOfStack, FunctionNode* surroundingFunc)
 {
-	CallTreeNode* Node = new CallTreeNode(NodeType, FuncNode);
+	CallTreeNode* Node = Graph->GetArena().Create<CallTreeNode>(this, NodeType, FuncNode);
  if(NodeType == Function){
   // warunung das hier muss später ersetzt werden so wird auch die Rekursion ausgeschlossen
 	 if(LastVisited == Function_Decl){
@@ -390,13 +435,103 @@ CallTreeNode* CallTree::registerNode(CallTreeNodeType NodeType, FunctionNode* Fu
 	return Node;
 }
 
+CallTreeNode* CallTree::registerCall(FunctionNode* FuncNode, bool VirtualCall, int Line, bool MergeCallSites, CallTreeNodeType LastVisited, PatternCodeRegion* TopOfStack, FunctionNode* surroundingFunc)
+{
+	CallTreeNode* Container = findCallContainer(LastVisited, TopOfStack, surroundingFunc);
+
+	if(Container == NULL){
+		//let registerNode report the missing caller
+		CallTreeNode* Node = registerNode(Function, FuncNode, LastVisited, TopOfStack, surroundingFunc);
+		Node->SetVirtualCall(VirtualCall);
+		Node->SetLineNumber(Line);
+		return Node;
+	}
+
+	if(MergeCallSites){
+		auto Merged = MergedCalls.find(std::make_pair(Container, FuncNode->GetHash()));
+
+		//a virtual call is linked to other declarations than a static call of the same function
+		if(Merged != MergedCalls.end() && Merged->second->IsVirtualCall() == VirtualCall){
+			addCallSite(Merged->second, Line);
+			return Merged->second;
+		}
+	}
+
+	//the container is the caller registerNode would look up again
+	CallTreeNode* Node = Graph->GetArena().Create<CallTreeNode>(this, Function, FuncNode);
+	Node->SetCaller(Container);
+	Container->insertCallee(Node);
+	Node->SetVirtualCall(VirtualCall);
+	Node->SetLineNumber(Line);
+
+	if(MergeCallSites){
+		MergedCalls.insert(std::make_pair(std::make_pair(Container, FuncNode->GetHash()), Node));
+	}
+
+	return Node;
+}
+
+void CallTree::addCallSite(CallTreeNode* Node, int Line)
+{
+	Node->IncreaseMultiplicity();
+	MergedCallSiteLines[Node].push_back(Line);
+}
+
+std::vector<int> CallTree::getCallSiteLines(CallTreeNode* Node)
+{
+	std::vector<int> Lines(1, Node->getLineNumber());
+	auto Merged = MergedCallSiteLines.find(Node);
+
+	if(Merged != MergedCallSiteLines.end()){
+		Lines.insert(Lines.end(), Merged->second.begin(), Merged->second.end());
+	}
+
+	return Lines;
+}
+
+CallTreeNode* CallTree::findCallContainer(CallTreeNodeType LastVisited, PatternCodeRegion* TopOfStack, FunctionNode* surroundingFunc)
+{
+	//index the declarations registered since the last lookup, their identifications are complete by now
+	for(; NumIndexedDeclarations < DeclarationVector.size(); NumIndexedDeclarations++){
+		CallTreeNode* Declaration = DeclarationVector[NumIndexedDeclarations];
+
+		//like the scans of appendCallerToNode, the first declaration with an identification wins
+		if(Declaration->GetNodeType() == Pattern_Begin){
+			PatternBeginsByID.try_emplace(Declaration->GetID()->getIdentificationString(), Declaration);
+		}else{
+			DeclarationsByID.try_emplace(Declaration->GetID()->getIdentificationHash(), Declaration);
+		}
+	}
+
+	//the same decision as in registerNode, see appendCallerToNode
+	if(LastVisited == Pattern_Begin && TopOfStack != NULL){
+		if(RootNode && RootNode->compare(TopOfStack->GetID())){
+			return RootNode;
+		}
+		auto Declaration = PatternBeginsByID.find(TopOfStack->GetID());
+		if(Declaration != PatternBeginsByID.end()){
+			return Declaration->second;
+		}
+	}
+	else if(LastVisited == Function_Decl || LastVisited == Pattern_Begin){
+		if(RootNode && RootNode->compare(surroundingFunc->GetHash())){
+			return RootNode;
+		}
+		auto Declaration = DeclarationsByID.find(surroundingFunc->GetHash());
+		if(Declaration != DeclarationsByID.end()){
+			return Declaration->second;
+		}
+	}
+	return NULL;
+}
+
 CallTreeNode* CallTree::registerEndNode(CallTreeNodeType NodeType, std::string identification, CallTreeNodeType LastVisited, PatternCodeRegion* TopOfStack, FunctionNode* surroundingFunc){
-	PatternCodeRegion* CorrespReg = PatternIDisUsed(identification);
+	PatternCodeRegion* CorrespReg = PatternIDisUsed(Graph, identification);
 	CallTreeNode* Node;
 	if(CorrespReg!=NULL)
-		Node = new CallTreeNode(NodeType, CorrespReg);
+		Node = Graph->GetArena().Create<CallTreeNode>(this, NodeType, CorrespReg);
 	else
-		Node = new CallTreeNode(NodeType, identification);
+		Node = Graph->GetArena().Create<CallTreeNode>(this, NodeType, identification);
 	#ifdef DEBUG
 		std::cout << "LastVisited = "<< LastVisited << '\n';
 	#endif
@@ -516,29 +651,11 @@ void CallTree::insertNodeIntoDeclVector(CallTreeNode* Node)
 	DeclarationVector.push_back(Node);
 }
 
-void CallTree::appendAllDeclToCallTree(CallTreeNode* Node, int maxdepth)
+void CallTree::appendAllDeclToCallTree(CallTreeNode* Node)
 {
-	//Traverse the tree and link every function call to its function declaration
-	class LinkFunctionToDeclarationVisitor : public CallTreeVisitor{
-		public:
-			LinkFunctionToDeclarationVisitor(int myMaximumRecursionDepth) :
-				CallTreeVisitor(myMaximumRecursionDepth){
-			}
-
-
-			void TraverseFunctionCall(CallTreeNode* Node) override{
-				for(CallTreeNode* Declaration : *ClTre -> GetDeclarationVector()){
-					if(Declaration -> compare(Node)){
-						ClTre -> appendCallerToNode(Node, Declaration);
-						Declaration -> Accept(this);
-						//TODO break;? Wouldn't a match only occur once?
-					}
-				}
-			}
-	};
-
-	LinkFunctionToDeclarationVisitor Visitor(maxdepth);
-	Node -> Accept(&Visitor);
+	CallTreeLinker Linker(this);
+	Linker.Link(Node);
+	Summaries.Clear();
 }
 
 void CallTree::setUpTree(){
@@ -550,7 +667,7 @@ void CallTree::setUpTree(){
 	#endif
 	for(CallTreeNode* EndNode : Pattern_EndVector){
 		if(EndNode->getCorrespondingCodeRegion()== NULL){
-			PatternCodeRegion* CorrespReg = PatternIDisUsed(EndNode->GetID()->getIdentificationString());
+			PatternCodeRegion* CorrespReg = PatternIDisUsed(Graph, EndNode->GetID()->getIdentificationString());
 			EndNode->setCorrespondingNode(CorrespReg);
 		}
 		else{
@@ -558,127 +675,38 @@ void CallTree::setUpTree(){
 			 std::cout << "EndNode->setCorrespondingNode(CorrespReg) is not NULL in setUpTree" << '\n';
 			#endif
 		}
-		#ifdef CURRDEBUG
-			std::cout << "Current End Node "<< '\n';
-			EndNode->print();
-		#endif
-		CallTreeNode* CorrespBegin  = findCorrespBegin(EndNode);
-		try{
-			if(CorrespBegin != NULL){
-				CorrespBegin->setCorrespCallTreeNodeRelation(EndNode);
-			}
-			else
-				throw TooManyEndsException();
-		}
-		catch(TooManyEndsException &e){
-			e.what();
-			throw TerminateEarlyException();
-		}
 	}
-	//check if we have too many Begins
+	//the matching moves callees, so the summaries of the subtrees change
+	Summaries.Clear();
 	try{
-	for(CallTreeNode* BeginNode : *GetDeclarationVector()){
-		if(BeginNode->GetNodeType()!= Pattern_Begin)
-			break;
-		if(BeginNode->getCorrespCallTreeNodeRelation()==NULL){
-			throw TooManyBeginsException(BeginNode->GetID()->getIdentificationString());
-		}
-	}
+		PatternNestingMatcher Matcher(this);
+		Matcher.Match(RootNode);
 	}
-	catch(TooManyBeginsException& exept){
-		exept.what();
+	catch(TooManyEndsException &e){
+		e.what();
 		throw TerminateEarlyException();
 	}
-}
-
-CallTreeNode* CallTree::findCorrespBegin(CallTreeNode* EndNode){
-	if(EndNode->GetNodeType() != Pattern_End)
-		return NULL;
-
-	CallTreeNode* Caller = EndNode->GetCaller();
-	CallTreeNode* Callertemp = EndNode;
-
-	#ifdef CURRDEBUG
-		std::cout << "Actual Caller: "<< *Caller->GetID()<<std::endl;
-	#endif
-
-	bool hasBegin = false;
-
-	while(!hasBegin){
-		if (Caller == NULL)
-			throw TooManyEndsException(EndNode->GetID()->getIdentificationString());
-
-		#ifdef CURRDEBUG
-			std::cout << "Actual Caller: " << '\n';
-			if(Caller != NULL)
-			std::cout<<	*Caller->GetID();
-			else
-				std::cout << "The Caller does not exist." << '\n';
-			std::cout << "Actual Node: "<< '\n';
-			Callertemp->print();
-		#endif
-
-		Caller->setLOCTillPatternEnd(Callertemp, EndNode);
-		hasBegin = Caller->compare(EndNode);
-
-		if(Caller->GetNodeType() == Pattern_Begin && !hasBegin){
-			EndNode->setSuitedForNestingStatisticsTo(false);
-			Caller->setSuitedForNestingStatisticsTo(false);
-
-			std::cout << "PRINTING PATTERN THAT ARE NOT SUITED FOR STATISTICS WHICH NEED CLEAR NESTING" << '\n';
-			std::cout << "Pattern " << *EndNode->GetID()<<" and "<< *Caller->GetID()<< " is not suited for statistics which need clear nesting of Pattern. " << '\n';
-			std::cout << "The first Pattern_Begin occurence before the Pattern_End of "<<*EndNode->GetID()<<" is "<< *Caller->GetID() << '\n';
-		}
-
-		if(hasBegin){
-			Caller->setCorrespCallTreeNodeRelation(EndNode);
-			EndNode->setCorrespCallTreeNodeRelation(Caller);
-			break;
+	//check if we have too many Begins
+	for(CallTreeNode* BeginNode : DeclarationVector){
+		if(BeginNode->GetNodeType() == Pattern_Begin && BeginNode->getCorrespCallTreeNodeRelation() == NULL){
+			throw TooManyBeginsException(BeginNode->GetID()->getIdentificationString());
 		}
-
-		Callertemp = Caller;
-		Caller = Callertemp->GetCaller();
 	}
-
-	if(hasBegin){
-		return Caller;
-	}
-	return NULL;
 }
 
- bool CallTree::lookIfTreeIsCorrect(){
-	 for(CallTreeNode* BeginNode : DeclarationVector){
-		 if(BeginNode->GetNodeType()== Pattern_Begin){
-			 if(!BeginNode->getCorrespCallTreeNodeRelation())
-			 throw TooManyBeginsException(BeginNode->GetID()->getIdentificationString());
-		 }
-	 }
-	 for(CallTreeNode* EndNode : Pattern_EndVector){
-		 if(EndNode->GetNodeType() == Pattern_End){
-			 if(!EndNode->getCorrespCallTreeNodeRelation())
-			 	throw TooManyEndsException(EndNode->GetID()->getIdentificationString());
-		 }
-	 }
-	 return true;
- }
-
 std::vector<CallTreeNode*>* CallTree::GetDeclarationVector(){
 	return &DeclarationVector;
 }
 
-CallTreeNode::~CallTreeNode(){
-	std::cout << "loesche gerade Knoten" << '\n';
-}
-
-CallTreeNode::CallTreeNode(CallTreeNodeType type, PatternCodeRegion* CorrespondingPat) : NodeType(type)
+CallTreeNode::CallTreeNode(CallTree* Tree, CallTreeNodeType type, PatternCodeRegion* CorrespondingPat) : NodeType(type)
 {
 	if(NodeType == Pattern_Begin)
 	{
-		ClTre->insertNodeIntoDeclVector(this);
+		Tree->insertNodeIntoDeclVector(this);
 	}
 	else if(NodeType == Pattern_End)
-		ClTre->insertNodeIntoPattern_EndVector(this);
-	ident = new Identification(type, CorrespondingPat->GetID());
+		Tree->insertNodeIntoPattern_EndVector(this);
+	ident = Tree->GetGraph()->GetArena().Create<Identification>(type, CorrespondingPat->GetID());
 	this->setCorrespondingNode(CorrespondingPat);
 	CorrespondingPat->insertCorrespondingCallTreeNode(this);
 
@@ -692,13 +720,13 @@ CallTreeNode::CallTreeNode(CallTreeNodeType type, PatternCodeRegion* Correspondi
 	#endif
 }
 
-CallTreeNode::CallTreeNode(CallTreeNodeType type ,FunctionNode* CorrespondingFunction) : NodeType(type)
+CallTreeNode::CallTreeNode(CallTree* Tree, CallTreeNodeType type ,FunctionNode* CorrespondingFunction) : NodeType(type)
 {
 	if(NodeType == Function_Decl)
 	{
-		ClTre->insertNodeIntoDeclVector(this);
+		Tree->insertNodeIntoDeclVector(this);
 	}
-	ident = new Identification(type, CorrespondingFunction->GetHash());
+	ident = Tree->GetGraph()->GetArena().Create<Identification>(type, CorrespondingFunction->GetHash());
 	this->setCorrespondingNode(CorrespondingFunction);
 	CorrespondingFunction->insertCorrespondingCallTreeNode(this);
 
@@ -708,28 +736,32 @@ CallTreeNode::CallTreeNode(CallTreeNodeType type ,FunctionNode* CorrespondingFun
 	#endif
 }
 
-CallTreeNode::CallTreeNode(CallTreeNodeType type, std::string identification): NodeType(type)
+CallTreeNode::CallTreeNode(CallTree* Tree, CallTreeNodeType type, std::string identification): NodeType(type)
 {
 	if(NodeType == Pattern_Begin)
 	{
-		ClTre->insertNodeIntoDeclVector(this);
+		Tree->insertNodeIntoDeclVector(this);
 	}
 	else if(NodeType == Pattern_End){
-		ClTre->insertNodeIntoPattern_EndVector(this);
+		Tree->insertNodeIntoPattern_EndVector(this);
 	}
-	ident = new Identification(type, identification);
+	ident = Tree->GetGraph()->GetArena().Create<Identification>(type, identification);
 	#ifdef DEBUG
 		std::cout << "Node of:"<<identification<< " is created"<< '\n';
 		std::cout << "Node Type = " << type << std::endl;
 	#endif
 }
 
+CallTreeNode::CallTreeNode(CallTreeNodeType type, Identification* ident): ident(ident), NodeType(type)
+{
+}
+
 Identification* CallTreeNode::GetID()
 {
 	return this->ident;
 }
 
-std::map<double, CallTreeNode*>* CallTreeNode::GetCallees(){
+CalleeList* CallTreeNode::GetCallees(){
 	return &Callees;
 }
 
@@ -737,37 +769,17 @@ CallTreeNode* CallTreeNode::GetCaller(){
 	return this->Caller;
 }
 
-void CallTreeNode::insertCallee(CallTreeNode* Node, double key){
+void CallTreeNode::insertCallee(CallTreeNode* Node){
+	// it is not allowed to appent the same object (with the same adress) twice
 	#ifdef DEBUG
-	std::cout << "in insertCallee" << '\n';
+	if(isAlreadyCallee(Node))
+		std::cout << *Node->GetID()<< " is already a callee of " << *GetID() << '\n';
 	#endif
-	// it is not allowed to appent the same object (with the same adress) twice
-	if(!isAlreadyCallee(Node)){
-		#ifdef DEBUG
-		std::cout << "!isAlreadyCallee = " << !isAlreadyCallee(Node) << '\n';
-		#endif
-		if(key != 0.0){
-			#ifdef DEBUG
-			std::cout << "inserting "<< *Node->GetID()<< " at position "<<key << '\n';
-			#endif
-			Callees[key] = Node;
-		}
-		else{
-			#ifdef DEBUG
-			std::cout << "inserting "<< *Node->GetID()<< " at position "<<actNumOfChild << '\n';
-			#endif
-			Callees[actNumOfChild] = Node;
-			actNumOfChild++;
-		}
-	}
+	Callees.PushBack(Node);
 }
 
 bool CallTreeNode::isAlreadyCallee(CallTreeNode* Callee){
-	for(const auto &calleePair: Callees){
-		if(calleePair.second == Callee)
-			return true;
-	}
-	return false;
+	return Callees.Contains(Callee);
 }
 
 void CallTreeNode::SetCaller(CallTreeNode* Node)
@@ -780,7 +792,7 @@ bool CallTreeNode::compare(CallTreeNode* otherNode)
 	return ident->compare(otherNode->GetID());
 }
 
-bool CallTreeNode::compare(unsigned Hash)
+bool CallTreeNode::compare(FunctionID Hash)
 {
 	return ident->compare(Hash);
 }
@@ -791,16 +803,15 @@ bool CallTreeNode::compare(std::string Id)
 }
 
 bool CallTreeNode::isCalleeOf(CallTreeNode* Caller){
-	for(const auto &CalleeOfCallerPair : *Caller->GetCallees())
+	for(CallTreeNode* CalleeOfCaller : *Caller->GetCallees())
 	{
-		CallTreeNode* CalleeOfCaller = CalleeOfCallerPair.second;
 		if(this->compare(CalleeOfCaller))
 			return true;
 	}
 	return false;
 }
 
-void CallTreeNode::print(){
+void CallTreeNode::print(const std::string& Label){
 	if((NodeType == Pattern_Begin || NodeType == Pattern_End)&& CorrespondingNode!= NULL && clang::dyn_cast<PatternCodeRegion>(CorrespondingNode)){
 		PatternCodeRegion* CorrespRegion = clang::dyn_cast<PatternCodeRegion>(CorrespondingNode);
 		std::cout << "\033[36m";
@@ -808,95 +819,21 @@ void CallTreeNode::print(){
 			std::cout << "END ";
 		}
 		std::cout << CorrespRegion->GetPatternOccurrence()->GetPattern()->GetDesignSpaceStr() << ":\33[33m " << CorrespRegion->GetPatternOccurrence()->GetPattern()->GetPatternName() << "\33[0m";
-			std::cout << "(" << *ident << ")" << std::endl;
+			std::cout << "(" << *ident << ")" << Label << std::endl;
 	}
 	else if((NodeType == Function || NodeType == Root) && CorrespondingNode!=NULL && clang::dyn_cast<FunctionNode>(CorrespondingNode)){
 		FunctionNode* CorrespFunc = clang::dyn_cast<FunctionNode>(CorrespondingNode);
-		std::cout << "\033[31m" << CorrespFunc->GetFnName() << "\033[0m" << " (Hash: " << *ident << ")" << std::endl;
+		std::cout << "\033[31m" << CorrespFunc->GetFnName() << "\033[0m" << " (Hash: " << *ident << ")";
+		if(Multiplicity > 1){
+			std::cout << " x" << Multiplicity;
+		}
+		std::cout << Label << std::endl;
 	}
 	else if(CorrespondingNode == NULL){
-		std::cout << "\033[36m" << "Only Printing Identification "<< ":\33[33m"<< *ident << "\033[0m" << std::endl;
+		std::cout << "\033[36m" << "Only Printing Identification "<< ":\33[33m"<< *ident << "\033[0m" << Label << std::endl;
 	}
 }
 
-void CallTreeNode::setLOCTillPatternEnd(CallTreeNode* Child, CallTreeNode* EndNode){
-	int locNodeToEndNode;
-	if(Child == EndNode){
-		#ifdef LOCDEBUG
-			std::cout << "Child and EndNode are the same." << '\n';
-		#endif
-		EndNode->insertLOCToPatternEnd(EndNode, 0);
-	}
-	if(Child->GetNodeType() == Function_Decl){
-		//copy corresponding entry of Function_Decl
-		auto correspEntry = (Child->getMapLOCToPatternEnds())->find(EndNode);
-		insertLOCToPatternEnd(correspEntry->first, correspEntry->second);
-		#ifdef LOCDEBUG
-			std::cout << "Copy operation:" << '\n';
-			std::cout << "copied "<<  *(correspEntry->first)->GetID()<<" "<< correspEntry->second<< " to "<< *GetID()<< '\n';
-		#endif
-	}
-	else{
-		int correspEntry = (Child->getMapLOCToPatternEnds())->find(EndNode)->second;
-		locNodeToEndNode = correspEntry + (Child->getLineNumber() - getLineNumber());
-		insertLOCToPatternEnd(EndNode, locNodeToEndNode);
-
-		#ifdef LOCDEBUG
-			int storedLineNumber = (getMapLOCToPatternEnds()->find(EndNode))->second;
-			std::cout << "FOR ENDNODE: "<<*EndNode->GetID() << '\n';
-			std::cout << "in setLOCTillPatternEnd: "<< correspEntry << " + "<<  *Child->GetID()<<" "<< Child->getLineNumber() << " - "<< *this->GetID()<<" "<<this->getLineNumber() << "= "<<locNodeToEndNode<< " verification" <<storedLineNumber << '\n';
-		#endif
-	}
-	if(this->compare(EndNode)){
-		locTillPatternEnd = getMapLOCToPatternEnds()->find(EndNode)->second;
-
-		/*delete all Children of the PatternBegin which are't really children
-		 * that means erasing all children which where assigned after this one
-		 * (have higher keys)
-		*/
-		std::map<double, CallTreeNode*>* MapCallees = GetCallees();
-		int childKey;
-		CallTreeNode* callerOfThis = GetCaller();
-		double callerChildKey;
-		std::map<double, CallTreeNode*>* mapCallerCallees = callerOfThis->GetCallees();
-		for(auto nodeEntry = mapCallerCallees->begin() ; nodeEntry != mapCallerCallees->end();){
-			if(nodeEntry->second == this){
-				callerChildKey = nodeEntry->first;
-				break;
-			}
-			else
-				nodeEntry++;
-		}
-
-		for(auto nodeEntry = MapCallees->begin() ; nodeEntry != MapCallees->end();){
-			if(nodeEntry->second == Child){
-				childKey = nodeEntry->first;
-			}//for every Child wich comes after the Child which contains the as the end as an
-			//successor. Delete the Child as A child of Pattern_Begin and add his child
-			// to the Caller of Pattern_Begin
-			if(nodeEntry->first > childKey){
-				#ifdef CHILDDEBUG
-					std::cout << "ERASING "<<nodeEntry->first << *((nodeEntry.second)->GetID()) << '\n';
-				#endif
-				callerChildKey += 0.1;
-				callerOfThis->insertCallee(nodeEntry->second, callerChildKey);
-				nodeEntry = MapCallees->erase(nodeEntry);
-			}
-			else{
-				nodeEntry++;
-			}
-
-		}
-		#ifdef LOCDEBUG
-			std::cout << "set locTillPatternEnd from "<< *GetID()<< " to "<< locTillPatternEnd << '\n';
-		#endif
-		}
-}
-
-void CallTreeNode::insertLOCToPatternEnd(CallTreeNode* Node, int Loc){
-	LocTillEnds.insert({Node, Loc});
-}
-
 void CallTreeNode::setSuitedForNestingStatisticsTo(bool suited){
 	isSuitedForNestingStatistics = suited;
 	PatternGraphNode* GraphNode = getCorrespondingCodeRegion();
@@ -911,8 +848,8 @@ std::ostream& operator<<(std::ostream &os, Identification const &ident)
 		return os << ident.getIdentificationString();
 
 	}
-	if(ident.getIdentificationUnsigned() != 0){
-		return os << ident.getIdentificationUnsigned();
+	if(ident.getIdentificationHash() != 0){
+		return os << ident.getIdentificationHash();
 	}
 	return os << "Something went wrong the Identification is not set";
 }
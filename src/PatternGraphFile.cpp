@@ -0,0 +1,934 @@
+#include "PatternGraphFile.h"
+
+#include "AnalysisContext.h"
+#include "PatternGraph.h"
+#include "HPCParallelPattern.h"
+#include "HPCError.h"
+#include "metric/fpa/ExternalInput.h"
+#include "metric/fpa/ExternalOutput.h"
+#include "metric/fpa/ExternalInquiry.h"
+#include "metric/fpa/InternalLogicalFile.h"
+#include "metric/fpa/ExternalInterfaceFile.h"
+
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/StringMap.h"
+#include "llvm/Support/MemoryBuffer.h"
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <functional>
+
+namespace
+{
+	const char Magic[8] = {'P', 'I', 'N', 'T', 'G', 'R', 'P', 'H'};
+
+	/* Has to be increased whenever the layout of a record changes.
+	 * Version 3 added the merged calls: CallTreeNodeRecord::CallSiteLines is a range of the index section, whose entries
+	 * are line numbers stored as uint32_t instead of indices. There is no separate record type for them. */
+	const uint32_t Version = 3;
+
+	const uint32_t NoIndex = ~0u;
+
+	enum SectionKind
+	{
+		SK_Strings,
+		SK_Files,
+		SK_Functions,
+		SK_Patterns,
+		SK_Occurrences,
+		SK_Regions,
+		SK_CallTreeNodes,
+		SK_Indices,
+		SK_StringLists,
+		SK_FunctionPoints,
+		SK_NumSections
+	};
+
+	struct SectionEntry
+	{
+		uint64_t Offset;
+		uint64_t Size;
+	};
+
+	struct FileHeader
+	{
+		char Magic[8];
+		uint32_t Version;
+		/* Graph node index of the designated root node */
+		uint32_t RootNode;
+		/* Call tree node index of the root of the call tree */
+		uint32_t CallTreeRoot;
+		uint32_t Reserved;
+		SectionEntry Sections[SK_NumSections];
+	};
+
+	/* A slice of the index section, the string list section etc. */
+	struct Range
+	{
+		uint32_t Begin;
+		uint32_t Count;
+	};
+
+	/* A string in the string table */
+	struct StringEntry
+	{
+		uint32_t Offset;
+		uint32_t Length;
+	};
+
+	struct LocationRecord
+	{
+		uint32_t FileID;
+		uint32_t Offset;
+		uint32_t Line;
+	};
+
+	struct FunctionRecord
+	{
+		uint64_t ID;
+		StringEntry Name;
+		Range Children;
+		Range Parents;
+		Range PatternParents;
+		Range PatternChildren;
+		Range CallTreeNodes;
+	};
+
+	struct PatternRecord
+	{
+		uint32_t DesignSp;
+		StringEntry Name;
+		Range Occurrences;
+		Range Operators;
+		Range Operands;
+		Range FunctionPoints;
+	};
+
+	struct OccurrenceRecord
+	{
+		uint32_t Pattern;
+		StringEntry ID;
+		/* The code regions of an occurrence are stored consecutively */
+		Range Regions;
+	};
+
+	struct RegionRecord
+	{
+		uint32_t Occurrence;
+		int32_t LinesOfCode;
+		LocationRecord Start;
+		LocationRecord End;
+		uint8_t SuitedForNesting;
+		uint8_t InMain;
+		uint8_t Padding[2];
+		Range Children;
+		Range Parents;
+		Range OnlyPatternChildren;
+		Range OnlyPatternParents;
+		Range CallTreeNodes;
+	};
+
+	struct CallTreeNodeRecord
+	{
+		uint64_t IdentHash;
+		StringEntry IdentString;
+		uint32_t Type;
+		/* Graph node index of the corresponding function or code region */
+		uint32_t Corresponding;
+		uint32_t Caller;
+		uint32_t CorrespPatCallNode;
+		int32_t Line;
+		int32_t LOCTillPatternEnd;
+		uint32_t SuitedForNesting;
+		/* Ranges into the index section */
+		Range Callees;
+		/* The lines of the further calls merged into the node, stored in the index section, see Version */
+		Range CallSiteLines;
+		/* Membership in the vectors of the CallTree: bit 0 for the declaration vector, bit 1 for the Pattern_End vector */
+		uint32_t CallTreeVectors;
+	};
+
+	struct FunctionPointRecord
+	{
+		StringEntry Type;
+		StringEntry Label;
+		int32_t DataElementTypes;
+		int32_t RecordElementTypes;
+		int32_t FileTypesReferenced;
+	};
+
+	/* The index section also holds the order of the CallTree vectors and the only-pattern roots */
+	struct ListsRecord
+	{
+		Range DeclarationVector;
+		Range PatternEndVector;
+		Range OnlyPatternRootNodes;
+	};
+
+	/**
+	 * Collects the records of all sections before they are written.
+	 */
+	class GraphWriter
+	{
+	public:
+		GraphWriter() : Strings(), StringOffsets()
+		{
+		}
+
+		void Collect(PatternGraph* Graph, PatternGraphNode* GraphRoot, CallTree* Tree);
+
+		void Write(const std::string& FileName);
+
+	private:
+		StringEntry AddString(const std::string& String);
+
+		template<typename NodeType>
+		Range AddNodes(const std::vector<NodeType*>& Nodes);
+
+		Range AddCallTreeNodes(const std::vector<CallTreeNode*>& Nodes);
+
+		uint32_t GetNodeIndex(PatternGraphNode* Node);
+
+		uint32_t GetCallTreeNodeIndex(CallTreeNode* Node);
+
+		void CollectCallTreeNodes(CallTree* Tree);
+
+		LocationRecord AddLocation(StableLocation Loc);
+
+		std::string Strings;
+		llvm::StringMap<uint32_t> StringOffsets;
+
+		std::vector<FunctionRecord> Functions;
+		std::vector<PatternRecord> Patterns;
+		std::vector<OccurrenceRecord> Occurrences;
+		std::vector<RegionRecord> Regions;
+		std::vector<CallTreeNodeRecord> CallTreeNodes;
+		std::vector<uint32_t> Indices;
+		std::vector<StringEntry> StringLists;
+		std::vector<FunctionPointRecord> FunctionPoints;
+		std::vector<StringEntry> Files;
+
+		ListsRecord Lists;
+		uint32_t RootNode = NoIndex;
+		uint32_t CallTreeRoot = NoIndex;
+
+		llvm::DenseMap<PatternGraphNode*, uint32_t> NodeIndices;
+		llvm::DenseMap<CallTreeNode*, uint32_t> CallTreeNodeIndices;
+		std::vector<CallTreeNode*> CallTreeNodeOrder;
+	};
+}
+
+StringEntry GraphWriter::AddString(const std::string& String)
+{
+	auto Entry = StringOffsets.insert({String, (uint32_t)Strings.size()});
+
+	if (Entry.second)
+	{
+		Strings.append(String);
+	}
+
+	return StringEntry{Entry.first->second, (uint32_t)String.size()};
+}
+
+template<typename NodeType>
+Range GraphWriter::AddNodes(const std::vector<NodeType*>& Nodes)
+{
+	Range Result{(uint32_t)Indices.size(), 0};
+
+	for (NodeType* Node : Nodes)
+	{
+		uint32_t Index = GetNodeIndex(Node);
+
+		if (Index != NoIndex)
+		{
+			Indices.push_back(Index);
+			Result.Count++;
+		}
+	}
+
+	return Result;
+}
+
+Range GraphWriter::AddCallTreeNodes(const std::vector<CallTreeNode*>& Nodes)
+{
+	Range Result{(uint32_t)Indices.size(), 0};
+
+	for (CallTreeNode* Node : Nodes)
+	{
+		Indices.push_back(GetCallTreeNodeIndex(Node));
+		Result.Count++;
+	}
+
+	return Result;
+}
+
+uint32_t GraphWriter::GetNodeIndex(PatternGraphNode* Node)
+{
+	auto Entry = NodeIndices.find(Node);
+	return Entry != NodeIndices.end() ? Entry->second : NoIndex;
+}
+
+uint32_t GraphWriter::GetCallTreeNodeIndex(CallTreeNode* Node)
+{
+	if (Node == NULL)
+	{
+		return NoIndex;
+	}
+
+	auto Entry = CallTreeNodeIndices.insert({Node, (uint32_t)CallTreeNodeOrder.size()});
+
+	if (Entry.second)
+	{
+		CallTreeNodeOrder.push_back(Node);
+	}
+
+	return Entry.first->second;
+}
+
+LocationRecord GraphWriter::AddLocation(StableLocation Loc)
+{
+	return LocationRecord{Loc.FileID, Loc.Offset, Loc.Line};
+}
+
+void GraphWriter::Collect(PatternGraph* Graph, PatternGraphNode* GraphRoot, CallTree* Tree)
+{
+	std::vector<FunctionNode*> AllFunctions = Graph->GetAllFunctions();
+	std::vector<HPCParallelPattern*> AllPatterns = Graph->GetAllPatterns();
+	std::vector<PatternOccurrence*> AllOccurrences = Graph->GetAllPatternOccurrence();
+	std::vector<PatternCodeRegion*> AllRegions = Graph->GetAllPatternCodeRegions();
+
+	/* Graph node indices: the functions first, then the code regions */
+	for (FunctionNode* Func : AllFunctions)
+	{
+		NodeIndices.insert({Func, (uint32_t)NodeIndices.size()});
+	}
+
+	for (PatternCodeRegion* CodeReg : AllRegions)
+	{
+		NodeIndices.insert({CodeReg, (uint32_t)NodeIndices.size()});
+	}
+
+	llvm::DenseMap<HPCParallelPattern*, uint32_t> PatternIndices;
+	llvm::DenseMap<PatternOccurrence*, uint32_t> OccurrenceIndices;
+
+	for (uint32_t Index = 0; Index < AllPatterns.size(); Index++)
+	{
+		PatternIndices[AllPatterns[Index]] = Index;
+	}
+
+	for (uint32_t Index = 0; Index < AllOccurrences.size(); Index++)
+	{
+		OccurrenceIndices[AllOccurrences[Index]] = Index;
+	}
+
+	/* The source files */
+	SourceFileTable& FileTable = Graph->GetFileTable();
+
+	for (unsigned FileID = 1; FileID < FileTable.GetNumFileIDs(); FileID++)
+	{
+		Files.push_back(AddString(FileTable.GetFileName(FileID)));
+	}
+
+	/* Patterns with their Halstead and function point data */
+	for (HPCParallelPattern* Pattern : AllPatterns)
+	{
+		PatternRecord Record;
+		Record.DesignSp = Pattern->GetDesignSpace();
+		Record.Name = AddString(Pattern->GetPatternName());
+
+		Record.Occurrences = Range{(uint32_t)Indices.size(), 0};
+
+		for (PatternOccurrence* PatternOcc : Pattern->GetOccurrences())
+		{
+			auto Entry = OccurrenceIndices.find(PatternOcc);
+
+			if (Entry != OccurrenceIndices.end())
+			{
+				Indices.push_back(Entry->second);
+				Record.Occurrences.Count++;
+			}
+		}
+
+		Record.Operators = Range{(uint32_t)StringLists.size(), (uint32_t)Pattern->GetOperators().size()};
+
+		for (const std::string& Operator : Pattern->GetOperators())
+		{
+			StringLists.push_back(AddString(Operator));
+		}
+
+		Record.Operands = Range{(uint32_t)StringLists.size(), (uint32_t)Pattern->GetOperands().size()};
+
+		for (const std::string& Operand : Pattern->GetOperands())
+		{
+			StringLists.push_back(AddString(Operand));
+		}
+
+		Record.FunctionPoints = Range{(uint32_t)FunctionPoints.size(), (uint32_t)Pattern->GetFunctionPoints().size()};
+
+		for (FunctionPoint* FP : Pattern->GetFunctionPoints())
+		{
+			FunctionPoints.push_back(FunctionPointRecord{
+				AddString(FP->GetType()), AddString(FP->Label),
+				FP->DataElementTypes, FP->RecordElementTypes, FP->FileTypesReferenced});
+		}
+
+		Patterns.push_back(Record);
+	}
+
+	/* Occurrences, their code regions are consecutive in the node order */
+	uint32_t FirstRegion = AllFunctions.size();
+
+	for (PatternOccurrence* PatternOcc : AllOccurrences)
+	{
+		auto Pattern = PatternIndices.find(PatternOcc->GetPattern());
+
+		OccurrenceRecord Record;
+		Record.Pattern = Pattern != PatternIndices.end() ? Pattern->second : NoIndex;
+		Record.ID = AddString(PatternOcc->GetID());
+		Record.Regions = Range{FirstRegion, (uint32_t)PatternOcc->GetNumberOfCodeRegions()};
+		FirstRegion += Record.Regions.Count;
+
+		Occurrences.push_back(Record);
+	}
+
+	/* Graph nodes and their edges */
+	for (FunctionNode* Func : AllFunctions)
+	{
+		FunctionRecord Record;
+		Record.ID = Func->GetHash();
+		Record.Name = AddString(Func->GetFnName());
+		Record.Children = AddNodes(Func->GetChildren());
+		Record.Parents = AddNodes(Func->GetParents());
+		Record.PatternParents = AddNodes(Func->GetPatternParents());
+		Record.PatternChildren = AddNodes(Func->GetPatternChildren());
+		Record.CallTreeNodes = AddCallTreeNodes(*Func->getCorrespondingCallTreeNodes());
+
+		Functions.push_back(Record);
+	}
+
+	for (PatternCodeRegion* CodeReg : AllRegions)
+	{
+		RegionRecord Record;
+		Record.Occurrence = OccurrenceIndices.lookup(CodeReg->GetPatternOccurrence());
+		Record.LinesOfCode = CodeReg->GetLinesOfCode();
+		Record.Start = AddLocation(CodeReg->GetStartLoc());
+		Record.End = AddLocation(CodeReg->GetEndLoc());
+		Record.SuitedForNesting = CodeReg->isSuitedForNestingStatistics;
+		Record.InMain = CodeReg->isInMain;
+		Record.Padding[0] = Record.Padding[1] = 0;
+		Record.Children = AddNodes(CodeReg->GetChildren());
+		Record.Parents = AddNodes(CodeReg->GetParents());
+		Record.OnlyPatternChildren = AddNodes(CodeReg->GetOnlyPatternChildren());
+		Record.OnlyPatternParents = AddNodes(CodeReg->GetOnlyPatternParents());
+		Record.CallTreeNodes = AddCallTreeNodes(*CodeReg->getCorrespondingCallTreeNodes());
+
+		Regions.push_back(Record);
+	}
+
+	if (GraphRoot != NULL)
+	{
+		RootNode = GetNodeIndex(GraphRoot);
+	}
+
+	Lists.OnlyPatternRootNodes = AddNodes(Graph->GetOnlyPatternRootNodes());
+
+	/* The call tree */
+	CallTreeRoot = GetCallTreeNodeIndex(Tree->getRoot());
+	Lists.DeclarationVector = AddCallTreeNodes(*Tree->GetDeclarationVector());
+	Lists.PatternEndVector = AddCallTreeNodes(*Tree->GetPatternEndVector());
+
+	CollectCallTreeNodes(Tree);
+}
+
+void GraphWriter::CollectCallTreeNodes(CallTree* Tree)
+{
+	llvm::DenseMap<CallTreeNode*, uint32_t> VectorMembership;
+
+	for (CallTreeNode* Node : *Tree->GetDeclarationVector())
+	{
+		VectorMembership[Node] |= 1;
+	}
+
+	for (CallTreeNode* Node : *Tree->GetPatternEndVector())
+	{
+		VectorMembership[Node] |= 2;
+	}
+
+	/* Referencing a node appends it to the order, so this loop reaches every node once */
+	for (size_t Index = 0; Index < CallTreeNodeOrder.size(); Index++)
+	{
+		CallTreeNode* Node = CallTreeNodeOrder[Index];
+		Identification* Ident = Node->GetID();
+
+		CallTreeNodeRecord Record;
+		Record.IdentHash = Ident->getIdentificationHash();
+		Record.IdentString = AddString(Ident->getIdentificationString());
+		Record.Type = Node->GetNodeType();
+		Record.Corresponding = Node->getCorrespondingCodeRegion() != NULL ? GetNodeIndex(Node->getCorrespondingCodeRegion()) : NoIndex;
+		Record.Caller = GetCallTreeNodeIndex(Node->GetCaller());
+		Record.CorrespPatCallNode = GetCallTreeNodeIndex(Node->getCorrespCallTreeNodeRelation());
+		Record.Line = Node->getLineNumber();
+		Record.LOCTillPatternEnd = *Node->getLOCTillPatternEnd();
+		Record.SuitedForNesting = Node->isSuitedForNestingStatistics;
+		Record.CallTreeVectors = VectorMembership.lookup(Node);
+
+		Record.Callees = Range{(uint32_t)Indices.size(), (uint32_t)Node->GetCallees()->Size()};
+
+		for (CallTreeNode* Callee : *Node->GetCallees())
+		{
+			Indices.push_back(GetCallTreeNodeIndex(Callee));
+		}
+
+		std::vector<int> Lines = Tree->getCallSiteLines(Node);
+		Record.CallSiteLines = Range{(uint32_t)Indices.size(), (uint32_t)Lines.size() - 1};
+
+		for (size_t Line = 1; Line < Lines.size(); Line++)
+		{
+			Indices.push_back((uint32_t)Lines[Line]);
+		}
+
+		CallTreeNodes.push_back(Record);
+	}
+}
+
+void GraphWriter::Write(const std::string& FileName)
+{
+	FileHeader Header;
+	std::memset(&Header, 0, sizeof(Header));
+	std::memcpy(Header.Magic, Magic, sizeof(Magic));
+	Header.Version = Version;
+	Header.RootNode = RootNode;
+	Header.CallTreeRoot = CallTreeRoot;
+
+	/* The lists are stored at the end of the index section */
+	Indices.push_back(Lists.DeclarationVector.Begin);
+	Indices.push_back(Lists.DeclarationVector.Count);
+	Indices.push_back(Lists.PatternEndVector.Begin);
+	Indices.push_back(Lists.PatternEndVector.Count);
+	Indices.push_back(Lists.OnlyPatternRootNodes.Begin);
+	Indices.push_back(Lists.OnlyPatternRootNodes.Count);
+
+	struct Section
+	{
+		const void* Data;
+		uint64_t Size;
+	};
+
+	Section Sections[SK_NumSections];
+	Sections[SK_Strings] = {Strings.data(), Strings.size()};
+	Sections[SK_Files] = {Files.data(), Files.size() * sizeof(StringEntry)};
+	Sections[SK_Functions] = {Functions.data(), Functions.size() * sizeof(FunctionRecord)};
+	Sections[SK_Patterns] = {Patterns.data(), Patterns.size() * sizeof(PatternRecord)};
+	Sections[SK_Occurrences] = {Occurrences.data(), Occurrences.size() * sizeof(OccurrenceRecord)};
+	Sections[SK_Regions] = {Regions.data(), Regions.size() * sizeof(RegionRecord)};
+	Sections[SK_CallTreeNodes] = {CallTreeNodes.data(), CallTreeNodes.size() * sizeof(CallTreeNodeRecord)};
+	Sections[SK_Indices] = {Indices.data(), Indices.size() * sizeof(uint32_t)};
+	Sections[SK_StringLists] = {StringLists.data(), StringLists.size() * sizeof(StringEntry)};
+	Sections[SK_FunctionPoints] = {FunctionPoints.data(), FunctionPoints.size() * sizeof(FunctionPointRecord)};
+
+	/* Every section starts at an offset aligned to 8 bytes, so the records can be used in place */
+	uint64_t Offset = sizeof(FileHeader);
+
+	for (int Kind = 0; Kind < SK_NumSections; Kind++)
+	{
+		Offset = (Offset + 7) & ~(uint64_t)7;
+		Header.Sections[Kind] = SectionEntry{Offset, Sections[Kind].Size};
+		Offset += Sections[Kind].Size;
+	}
+
+	std::ofstream File(FileName, std::ios::binary | std::ios::trunc);
+	File.write((const char*)&Header, sizeof(Header));
+
+	uint64_t Written = sizeof(FileHeader);
+	const char Zeros[8] = {0};
+
+	for (int Kind = 0; Kind < SK_NumSections; Kind++)
+	{
+		File.write(Zeros, Header.Sections[Kind].Offset - Written);
+		File.write((const char*)Sections[Kind].Data, Sections[Kind].Size);
+		Written = Header.Sections[Kind].Offset + Sections[Kind].Size;
+	}
+
+	File.close();
+
+	if (!File)
+	{
+		throw GraphFileException(FileName, "the file could not be written");
+	}
+}
+
+void PatternGraphFile::Save(AnalysisContext& Analysis, const std::string& FileName)
+{
+	GraphWriter Writer;
+	Writer.Collect(&Analysis.GetGraph(), Analysis.GetGraph().RootNode, &Analysis.GetCallTree());
+	Writer.Write(FileName);
+}
+
+
+
+namespace
+{
+	/**
+	 * Gives typed access to the sections of a mapped graph file and checks all references against the section sizes.
+	 */
+	class GraphReader
+	{
+	public:
+		GraphReader(const std::string& FileName, const llvm::MemoryBuffer& Buffer) : FileName(FileName), Buffer(Buffer)
+		{
+			if (Buffer.getBufferSize() < sizeof(FileHeader))
+			{
+				Fail("the file is too small");
+			}
+
+			Header = (const FileHeader*)Buffer.getBufferStart();
+
+			if (std::memcmp(Header->Magic, Magic, sizeof(Magic)) != 0)
+			{
+				Fail("the file is not a pattern graph");
+			}
+
+			if (Header->Version != Version)
+			{
+				Fail("the file was written by a different version of the tool");
+			}
+
+			for (int Kind = 0; Kind < SK_NumSections; Kind++)
+			{
+				const SectionEntry& Entry = Header->Sections[Kind];
+
+				if (Entry.Offset % 8 != 0 || Entry.Offset > Buffer.getBufferSize() || Entry.Size > Buffer.getBufferSize() - Entry.Offset)
+				{
+					Fail("the file is truncated or corrupt");
+				}
+			}
+		}
+
+		template<typename RecordType>
+		const RecordType* GetSection(SectionKind Kind, size_t& Count)
+		{
+			Count = Header->Sections[Kind].Size / sizeof(RecordType);
+			return (const RecordType*)(Buffer.getBufferStart() + Header->Sections[Kind].Offset);
+		}
+
+		std::string GetString(StringEntry Entry)
+		{
+			const SectionEntry& Strings = Header->Sections[SK_Strings];
+
+			if ((uint64_t)Entry.Offset + Entry.Length > Strings.Size)
+			{
+				Fail("a string lies outside of the string table");
+			}
+
+			return std::string(Buffer.getBufferStart() + Strings.Offset + Entry.Offset, Entry.Length);
+		}
+
+		void CheckRange(Range R, size_t Count)
+		{
+			if ((uint64_t)R.Begin + R.Count > Count)
+			{
+				Fail("a reference lies outside of its section");
+			}
+		}
+
+		void CheckIndex(uint32_t Index, size_t Count)
+		{
+			if (Index != NoIndex && Index >= Count)
+			{
+				Fail("a reference lies outside of its section");
+			}
+		}
+
+		[[noreturn]] void Fail(const std::string& Reason)
+		{
+			throw GraphFileException(FileName, Reason);
+		}
+
+		const FileHeader* Header;
+
+	private:
+		const std::string& FileName;
+
+		const llvm::MemoryBuffer& Buffer;
+	};
+}
+
+void PatternGraphFile::Load(AnalysisContext& Analysis, const std::string& FileName)
+{
+	llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> Buffer = llvm::MemoryBuffer::getFile(FileName, false, false);
+
+	if (!Buffer)
+	{
+		throw GraphFileException(FileName, Buffer.getError().message());
+	}
+
+	GraphReader Reader(FileName, **Buffer);
+	PatternGraph* Graph = &Analysis.GetGraph();
+	CallTree* Tree = &Analysis.GetCallTree();
+	AnalysisArena& Arena = Graph->GetArena();
+
+	size_t NumFiles, NumFunctions, NumPatterns, NumOccurrences, NumRegions, NumCallTreeNodes;
+	size_t NumIndices, NumStringLists, NumFunctionPoints;
+
+	const StringEntry* Files = Reader.GetSection<StringEntry>(SK_Files, NumFiles);
+	const FunctionRecord* Functions = Reader.GetSection<FunctionRecord>(SK_Functions, NumFunctions);
+	const PatternRecord* Patterns = Reader.GetSection<PatternRecord>(SK_Patterns, NumPatterns);
+	const OccurrenceRecord* Occurrences = Reader.GetSection<OccurrenceRecord>(SK_Occurrences, NumOccurrences);
+	const RegionRecord* Regions = Reader.GetSection<RegionRecord>(SK_Regions, NumRegions);
+	const CallTreeNodeRecord* CallTreeNodes = Reader.GetSection<CallTreeNodeRecord>(SK_CallTreeNodes, NumCallTreeNodes);
+	const uint32_t* Indices = Reader.GetSection<uint32_t>(SK_Indices, NumIndices);
+	const StringEntry* StringLists = Reader.GetSection<StringEntry>(SK_StringLists, NumStringLists);
+	const FunctionPointRecord* FunctionPoints = Reader.GetSection<FunctionPointRecord>(SK_FunctionPoints, NumFunctionPoints);
+
+	size_t NumNodes = NumFunctions + NumRegions;
+
+	for (size_t Index = 0; Index < NumFiles; Index++)
+	{
+		Graph->GetFileTable().GetFileID(Reader.GetString(Files[Index]));
+	}
+
+	/* Create all objects first, so the references can be resolved afterwards */
+	std::vector<PatternGraphNode*> Nodes(NumNodes);
+	std::vector<HPCParallelPattern*> PatternObjects(NumPatterns);
+	std::vector<PatternOccurrence*> OccurrenceObjects(NumOccurrences);
+	std::vector<CallTreeNode*> CallTreeNodeObjects(NumCallTreeNodes);
+
+	for (size_t Index = 0; Index < NumFunctions; Index++)
+	{
+		FunctionNode* Func = Arena.Create<FunctionNode>(Reader.GetString(Functions[Index].Name), Functions[Index].ID);
+		Graph->Functions.push_back(Func);
+		Graph->FunctionsByHash.insert({Func->GetHash(), Func});
+		Nodes[Index] = Func;
+	}
+
+	for (size_t Index = 0; Index < NumPatterns; Index++)
+	{
+		const PatternRecord& Record = Patterns[Index];
+		HPCParallelPattern* Pattern = Arena.Create<HPCParallelPattern>((DesignSpace)Record.DesignSp, Reader.GetString(Record.Name));
+
+		Reader.CheckRange(Record.Operators, NumStringLists);
+		Reader.CheckRange(Record.Operands, NumStringLists);
+		Reader.CheckRange(Record.FunctionPoints, NumFunctionPoints);
+
+		for (uint32_t Operator = 0; Operator < Record.Operators.Count; Operator++)
+		{
+			Pattern->IncrementNumberOfOperators(Reader.GetString(StringLists[Record.Operators.Begin + Operator]));
+		}
+
+		for (uint32_t Operand = 0; Operand < Record.Operands.Count; Operand++)
+		{
+			Pattern->IncrementNumberOfOperands(Reader.GetString(StringLists[Record.Operands.Begin + Operand]));
+		}
+
+		for (uint32_t Point = 0; Point < Record.FunctionPoints.Count; Point++)
+		{
+			const FunctionPointRecord& FP = FunctionPoints[Record.FunctionPoints.Begin + Point];
+			std::string Type = Reader.GetString(FP.Type);
+			std::string Label = Reader.GetString(FP.Label);
+			FunctionPoint* NewFunctionPoint;
+
+			if (Type == "EI")
+				NewFunctionPoint = Arena.Create<ExternalInput>(FP.DataElementTypes, FP.FileTypesReferenced, Label);
+			else if (Type == "EO")
+				NewFunctionPoint = Arena.Create<ExternalOutput>(FP.DataElementTypes, FP.FileTypesReferenced, Label);
+			else if (Type == "EQ")
+				NewFunctionPoint = Arena.Create<ExternalInquiry>(FP.DataElementTypes, FP.FileTypesReferenced, Label);
+			else if (Type == "ILF")
+				NewFunctionPoint = Arena.Create<InternalLogicalFile>(FP.DataElementTypes, FP.RecordElementTypes, Label);
+			else if (Type == "EIF")
+				NewFunctionPoint = Arena.Create<ExternalInterfaceFile>(FP.DataElementTypes, FP.RecordElementTypes, Label);
+			else
+				Reader.Fail("unknown function point type " + Type);
+
+			Pattern->AddFunctionPoint(NewFunctionPoint);
+		}
+
+		Graph->Patterns.push_back(Pattern);
+		PatternObjects[Index] = Pattern;
+	}
+
+	for (size_t Index = 0; Index < NumOccurrences; Index++)
+	{
+		const OccurrenceRecord& Record = Occurrences[Index];
+		Reader.CheckIndex(Record.Pattern, NumPatterns);
+		Reader.CheckRange(Record.Regions, NumNodes);
+
+		if (Record.Pattern == NoIndex || Record.Regions.Begin < NumFunctions)
+		{
+			Reader.Fail("an occurrence has no pattern or invalid code regions");
+		}
+
+		PatternOccurrence* PatternOcc = Arena.Create<PatternOccurrence>(PatternObjects[Record.Pattern], Reader.GetString(Record.ID));
+
+		for (uint32_t Region = Record.Regions.Begin; Region < Record.Regions.Begin + Record.Regions.Count; Region++)
+		{
+			PatternCodeRegion* CodeReg = Arena.Create<PatternCodeRegion>(PatternOcc);
+			const RegionRecord& RegRecord = Regions[Region - NumFunctions];
+
+			CodeReg->SetLinesOfCode(RegRecord.LinesOfCode);
+			CodeReg->SetStartSourceLoc(StableLocation(RegRecord.Start.FileID, RegRecord.Start.Offset, RegRecord.Start.Line));
+			CodeReg->SetEndSourceLoc(StableLocation(RegRecord.End.FileID, RegRecord.End.Offset, RegRecord.End.Line));
+			CodeReg->isSuitedForNestingStatistics = RegRecord.SuitedForNesting;
+			CodeReg->isInMain = RegRecord.InMain;
+
+			PatternOcc->AddCodeRegion(CodeReg);
+			Nodes[Region] = CodeReg;
+		}
+
+		Graph->PatternOccurrences.push_back(PatternOcc);
+		OccurrenceObjects[Index] = PatternOcc;
+	}
+
+	for (size_t Index = NumFunctions; Index < NumNodes; Index++)
+	{
+		if (Nodes[Index] == NULL)
+		{
+			Reader.Fail("a code region belongs to no occurrence");
+		}
+	}
+
+	for (size_t Index = 0; Index < NumPatterns; Index++)
+	{
+		const Range& Occs = Patterns[Index].Occurrences;
+		Reader.CheckRange(Occs, NumIndices);
+
+		for (uint32_t Occ = Occs.Begin; Occ < Occs.Begin + Occs.Count; Occ++)
+		{
+			Reader.CheckIndex(Indices[Occ], NumOccurrences);
+			PatternObjects[Index]->AddOccurrence(OccurrenceObjects[Indices[Occ]]);
+		}
+	}
+
+	for (size_t Index = 0; Index < NumCallTreeNodes; Index++)
+	{
+		const CallTreeNodeRecord& Record = CallTreeNodes[Index];
+		CallTreeNodeType Type = (CallTreeNodeType)Record.Type;
+		Identification* Ident;
+
+		if (Type == Pattern_Begin || Type == Pattern_End)
+			Ident = Arena.Create<Identification>(Type, Reader.GetString(Record.IdentString));
+		else
+			Ident = Arena.Create<Identification>(Type, (FunctionID)Record.IdentHash);
+
+		CallTreeNodeObjects[Index] = Arena.Create<CallTreeNode>(Type, Ident);
+	}
+
+	/* Resolves a range of graph node references */
+	auto ForNodes = [&](Range R, std::function<void(PatternGraphNode*)> Callback) {
+		Reader.CheckRange(R, NumIndices);
+
+		for (uint32_t Ref = R.Begin; Ref < R.Begin + R.Count; Ref++)
+		{
+			Reader.CheckIndex(Indices[Ref], NumNodes);
+			Callback(Nodes[Indices[Ref]]);
+		}
+	};
+
+	auto ForCallTreeNodes = [&](Range R, std::function<void(CallTreeNode*)> Callback) {
+		Reader.CheckRange(R, NumIndices);
+
+		for (uint32_t Ref = R.Begin; Ref < R.Begin + R.Count; Ref++)
+		{
+			if (Indices[Ref] == NoIndex)
+			{
+				Reader.Fail("a call tree reference is empty");
+			}
+
+			Reader.CheckIndex(Indices[Ref], NumCallTreeNodes);
+			Callback(CallTreeNodeObjects[Indices[Ref]]);
+		}
+	};
+
+	auto AsCodeRegion = [&](PatternGraphNode* Node) {
+		PatternCodeRegion* CodeReg = clang::dyn_cast<PatternCodeRegion>(Node);
+
+		if (CodeReg == NULL)
+		{
+			Reader.Fail("a pattern edge points to a function");
+		}
+
+		return CodeReg;
+	};
+
+	/* Edges of the pattern graph, in their original order */
+	for (size_t Index = 0; Index < NumFunctions; Index++)
+	{
+		const FunctionRecord& Record = Functions[Index];
+		FunctionNode* Func = clang::cast<FunctionNode>(Nodes[Index]);
+
+		ForNodes(Record.Children, [&](PatternGraphNode* Node) { Func->AddChild(Node); });
+		ForNodes(Record.Parents, [&](PatternGraphNode* Node) { Func->AddParent(Node); });
+		ForNodes(Record.PatternParents, [&](PatternGraphNode* Node) { Func->AddPatternParent(AsCodeRegion(Node)); });
+		ForNodes(Record.PatternChildren, [&](PatternGraphNode* Node) { Func->AddPatternChild(AsCodeRegion(Node)); });
+		ForCallTreeNodes(Record.CallTreeNodes, [&](CallTreeNode* Node) { Func->insertCorrespondingCallTreeNode(Node); });
+	}
+
+	for (size_t Index = NumFunctions; Index < NumNodes; Index++)
+	{
+		const RegionRecord& Record = Regions[Index - NumFunctions];
+		PatternCodeRegion* CodeReg = clang::cast<PatternCodeRegion>(Nodes[Index]);
+
+		ForNodes(Record.Children, [&](PatternGraphNode* Node) { CodeReg->AddChild(Node); });
+		ForNodes(Record.Parents, [&](PatternGraphNode* Node) { CodeReg->AddParent(Node); });
+		ForNodes(Record.OnlyPatternChildren, [&](PatternGraphNode* Node) { CodeReg->AddOnlyPatternChild(AsCodeRegion(Node)); });
+		ForNodes(Record.OnlyPatternParents, [&](PatternGraphNode* Node) { CodeReg->AddOnlyPatternParent(AsCodeRegion(Node)); });
+		ForCallTreeNodes(Record.CallTreeNodes, [&](CallTreeNode* Node) { CodeReg->insertCorrespondingCallTreeNode(Node); });
+	}
+
+	/* Relations of the call tree */
+	for (size_t Index = 0; Index < NumCallTreeNodes; Index++)
+	{
+		const CallTreeNodeRecord& Record = CallTreeNodes[Index];
+		CallTreeNode* Node = CallTreeNodeObjects[Index];
+
+		Reader.CheckIndex(Record.Corresponding, NumNodes);
+		Reader.CheckIndex(Record.Caller, NumCallTreeNodes);
+		Reader.CheckIndex(Record.CorrespPatCallNode, NumCallTreeNodes);
+
+		if (Record.Corresponding != NoIndex)
+			Node->setCorrespondingNode(Nodes[Record.Corresponding]);
+		if (Record.Caller != NoIndex)
+			Node->SetCaller(CallTreeNodeObjects[Record.Caller]);
+		if (Record.CorrespPatCallNode != NoIndex)
+			Node->setCorrespCallTreeNodeRelation(CallTreeNodeObjects[Record.CorrespPatCallNode]);
+
+		Node->SetLineNumber(Record.Line);
+		Node->setLOCTillPatternEnd(Record.LOCTillPatternEnd);
+		Node->isSuitedForNestingStatistics = Record.SuitedForNesting;
+
+		ForCallTreeNodes(Record.Callees, [&](CallTreeNode* Callee) { Node->insertCallee(Callee); });
+
+		Reader.CheckRange(Record.CallSiteLines, NumIndices);
+
+		for (uint32_t Line = Record.CallSiteLines.Begin; Line < Record.CallSiteLines.Begin + Record.CallSiteLines.Count; Line++)
+		{
+			Tree->addCallSite(Node, (int)Indices[Line]);
+		}
+	}
+
+	/* The lists are stored at the end of the index section */
+	if (NumIndices < 6)
+	{
+		Reader.Fail("the index section is truncated");
+	}
+
+	const uint32_t* ListRanges = Indices + NumIndices - 6;
+
+	ForCallTreeNodes(Range{ListRanges[0], ListRanges[1]}, [&](CallTreeNode* Node) { Tree->insertNodeIntoDeclVector(Node); });
+	ForCallTreeNodes(Range{ListRanges[2], ListRanges[3]}, [&](CallTreeNode* Node) { Tree->insertNodeIntoPattern_EndVector(Node); });
+	ForNodes(Range{ListRanges[4], ListRanges[5]}, [&](PatternGraphNode* Node) { Graph->RegisterOnlyPatternRootNode(AsCodeRegion(Node)); });
+
+	Reader.CheckIndex(Reader.Header->RootNode, NumNodes);
+	Reader.CheckIndex(Reader.Header->CallTreeRoot, NumCallTreeNodes);
+
+	if (Reader.Header->RootNode != NoIndex)
+	{
+		Graph->RootNode = Nodes[Reader.Header->RootNode];
+	}
+
+	if (Reader.Header->CallTreeRoot != NoIndex)
+	{
+		Tree->setRootNode(CallTreeNodeObjects[Reader.Header->CallTreeRoot]);
+	}
+}
@@ -0,0 +1,153 @@
+#include "PatternGraphSnapshot.h"
+
+#include "PatternGraph.h"
+#include "HPCParallelPattern.h"
+
+#include "llvm/ADT/DenseMap.h"
+
+PatternCodeRegion* PatternGraphSnapshot::GetCodeRegion(NodeIndex Node) const
+{
+	return clang::cast<PatternCodeRegion>(Nodes[Node]);
+}
+
+bool PatternGraphSnapshot::Contains(PatternGraphNode* Node) const
+{
+	NodeIndex Index = Node->GetSnapshotIndex();
+
+	return Index < Nodes.size() && Nodes[Index] == Node;
+}
+
+template<typename NodeType>
+void PatternGraphSnapshot::AppendRow(Adjacency& Edges, const std::vector<NodeType*>& Targets)
+{
+	for (NodeType* Target : Targets)
+	{
+		if (Contains(Target))
+		{
+			Edges.Targets.push_back(Target->GetSnapshotIndex());
+		}
+	}
+
+	Edges.Offsets.push_back(Edges.Targets.size());
+}
+
+PatternGraphSnapshot::PatternGraphSnapshot(PatternGraph* Graph)
+{
+	std::vector<FunctionNode*> Functions = Graph->GetAllFunctions();
+	std::vector<PatternCodeRegion*> CodeRegions = Graph->GetAllPatternCodeRegions();
+
+	/* Assign the indices first, so edges between all nodes can be resolved */
+	NumFunctions = Functions.size();
+	Nodes.reserve(Functions.size() + CodeRegions.size());
+	Nodes.insert(Nodes.end(), Functions.begin(), Functions.end());
+	Nodes.insert(Nodes.end(), CodeRegions.begin(), CodeRegions.end());
+
+	for (NodeIndex Index = 0; Index < Nodes.size(); Index++)
+	{
+		Nodes[Index]->SetSnapshotIndex(Index);
+	}
+
+	if (Graph->RootNode != NULL && Contains(Graph->RootNode))
+	{
+		RootNode = Graph->RootNode->GetSnapshotIndex();
+	}
+
+	/* Patterns and their code regions */
+	Patterns = Graph->GetAllPatterns();
+	llvm::DenseMap<HPCParallelPattern*, unsigned> PatternIndices;
+	RegionsOfPattern.Offsets.push_back(0);
+
+	for (unsigned PatternIndex = 0; PatternIndex < Patterns.size(); PatternIndex++)
+	{
+		PatternIndices[Patterns[PatternIndex]] = PatternIndex;
+		AppendRow(RegionsOfPattern, Patterns[PatternIndex]->GetCodeRegions());
+	}
+
+	/* Edges and dense attributes of all nodes */
+	Children.Offsets.push_back(0);
+	Parents.Offsets.push_back(0);
+	OnlyPatternChildren.Offsets.push_back(0);
+	OnlyPatternParents.Offsets.push_back(0);
+
+	PatternOfNode.resize(Nodes.size(), InvalidIndex);
+	LinesOfCode.resize(Nodes.size(), 0);
+	SuitedForNesting.resize(Nodes.size(), 0);
+
+	for (NodeIndex Index = 0; Index < Nodes.size(); Index++)
+	{
+		PatternGraphNode* Node = Nodes[Index];
+
+		AppendRow(Children, Node->GetChildren());
+		AppendRow(Parents, Node->GetParents());
+
+		if (PatternCodeRegion* CodeReg = clang::dyn_cast<PatternCodeRegion>(Node))
+		{
+			AppendRow(OnlyPatternChildren, CodeReg->GetOnlyPatternChildren());
+			AppendRow(OnlyPatternParents, CodeReg->GetOnlyPatternParents());
+
+			auto PatternIndex = PatternIndices.find(CodeReg->GetPatternOccurrence()->GetPattern());
+
+			if (PatternIndex != PatternIndices.end())
+			{
+				PatternOfNode[Index] = PatternIndex->second;
+			}
+
+			LinesOfCode[Index] = CodeReg->GetLinesOfCode();
+			SuitedForNesting[Index] = CodeReg->isSuitedForNestingStatistics;
+		}
+		else
+		{
+			OnlyPatternChildren.Offsets.push_back(OnlyPatternChildren.Targets.size());
+			OnlyPatternParents.Offsets.push_back(OnlyPatternParents.Targets.size());
+		}
+	}
+
+	MarkConnectedComponents();
+}
+
+/**
+ * Labels the components in the order of their first code region,
+ * with an explicit stack instead of recursion and without touching the nodes.
+ */
+void PatternGraphSnapshot::MarkConnectedComponents()
+{
+	ConnectedComponent.assign(Nodes.size(), -1);
+	NumConnectedComponents = 0;
+
+	std::vector<NodeIndex> Stack;
+
+	for (NodeIndex Start = NumFunctions; Start < Nodes.size(); Start++)
+	{
+		if (ConnectedComponent[Start] != -1)
+		{
+			continue;
+		}
+
+		Stack.push_back(Start);
+
+		while (!Stack.empty())
+		{
+			NodeIndex Current = Stack.back();
+			Stack.pop_back();
+
+			if (ConnectedComponent[Current] != -1)
+			{
+				continue;
+			}
+
+			ConnectedComponent[Current] = NumConnectedComponents;
+
+			for (NodeIndex Child : GetChildren(Current))
+			{
+				Stack.push_back(Child);
+			}
+
+			for (NodeIndex Parent : GetParents(Current))
+			{
+				Stack.push_back(Parent);
+			}
+		}
+
+		NumConnectedComponents++;
+	}
+}
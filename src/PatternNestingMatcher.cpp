@@ -0,0 +1,187 @@
+#include "PatternNestingMatcher.h"
+#include "HPCError.h"
+
+#include <iostream>
+
+PatternNestingMatcher::PatternNestingMatcher(CallTree* Tree) : Tree(Tree)
+{
+
+}
+
+void PatternNestingMatcher::Match(CallTreeNode* Root)
+{
+	Sweep(Root);
+
+	for (CallTreeNode* EndNode : *Tree->GetPatternEndVector())
+	{
+		if (Visited.count(EndNode))
+		{
+			continue;
+		}
+
+		/* The Pattern_End is not reachable from the root, e.g. because its function is never called */
+		CallTreeNode* Top = EndNode;
+
+		while (Top->GetCaller() != NULL && !Visited.count(Top->GetCaller()))
+		{
+			Top = Top->GetCaller();
+		}
+
+		Sweep(Top);
+	}
+}
+
+void PatternNestingMatcher::Sweep(CallTreeNode* Top)
+{
+	if (Top->GetNodeType() == Pattern_End)
+	{
+		Visited.insert(Top);
+		MatchEnd(Top, 0);
+		return;
+	}
+
+	Enter(Top, 0);
+
+	while (!Frames.empty())
+	{
+		Frame& Current = Frames.back();
+		CalleeList* Callees = Current.Node->GetCallees();
+
+		/* The number of callees is read in every step, because matching a Pattern_End moves callees */
+		if (Current.Next >= Callees->Size())
+		{
+			Leave();
+			continue;
+		}
+
+		CallTreeNode* Callee = (*Callees)[Current.Next];
+		Current.Next++;
+
+		/* Only the edges of the tree spanned by the callers are followed, so every node is reached once */
+		if (Callee->GetCaller() != Current.Node || Visited.count(Callee))
+		{
+			continue;
+		}
+
+		int Offset = Current.Offset + GetLineDistance(Callee, Current.Node);
+
+		if (Callee->GetNodeType() == Pattern_End)
+		{
+			Visited.insert(Callee);
+			MatchEnd(Callee, Offset);
+		}
+		else
+		{
+			/* Enter may grow the frames, so Current must not be used afterwards */
+			Enter(Callee, Offset);
+		}
+	}
+}
+
+void PatternNestingMatcher::Enter(CallTreeNode* Node, int Offset)
+{
+	Visited.insert(Node);
+	Frames.push_back(Frame{Node, 0, Offset});
+
+	if (Node->GetNodeType() == Pattern_Begin)
+	{
+		OpenBegins[Node->GetID()->getIdentificationString()].push_back(BeginStack.size());
+		BeginStack.push_back(Frames.size() - 1);
+	}
+}
+
+void PatternNestingMatcher::Leave()
+{
+	CallTreeNode* Node = Frames.back().Node;
+
+	if (Node->GetNodeType() == Pattern_Begin)
+	{
+		BeginStack.pop_back();
+		OpenBegins[Node->GetID()->getIdentificationString()].pop_back();
+	}
+
+	Frames.pop_back();
+}
+
+void PatternNestingMatcher::MatchEnd(CallTreeNode* EndNode, int Offset)
+{
+	auto Open = OpenBegins.find(EndNode->GetID()->getIdentificationString());
+	bool HasBegin = Open != OpenBegins.end() && !Open->second.empty();
+
+	/* The Pattern_Begin nodes opened after the matching one, innermost first */
+	size_t First = HasBegin ? Open->second.back() + 1 : 0;
+
+	for (size_t Position = BeginStack.size(); Position > First; Position--)
+	{
+		MarkNotSuited(Frames[BeginStack[Position - 1]].Node, EndNode);
+	}
+
+	if (!HasBegin)
+	{
+		throw TooManyEndsException(EndNode->GetID()->getIdentificationString());
+	}
+
+	size_t BeginFrame = BeginStack[First - 1];
+	CallTreeNode* BeginNode = Frames[BeginFrame].Node;
+
+	BeginNode->setCorrespCallTreeNodeRelation(EndNode);
+	EndNode->setCorrespCallTreeNodeRelation(BeginNode);
+
+	int Loc = Offset - Frames[BeginFrame].Offset;
+	BeginNode->setLOCTillPatternEnd(Loc);
+
+#ifdef LOCDEBUG
+	std::cout << "set locTillPatternEnd from " << *BeginNode->GetID() << " to " << Loc << '\n';
+#endif
+
+	MoveCalleesBehindBegin(BeginFrame);
+}
+
+void PatternNestingMatcher::MoveCalleesBehindBegin(size_t BeginFrame)
+{
+	CallTreeNode* BeginNode = Frames[BeginFrame].Node;
+	CallTreeNode* CallerOfBegin = BeginNode->GetCaller();
+
+	if (BeginFrame == 0 || Frames[BeginFrame - 1].Node != CallerOfBegin)
+	{
+		return;
+	}
+
+	CalleeList* Callees = BeginNode->GetCallees();
+	size_t ChildPos = Frames[BeginFrame].Next - 1;
+	size_t BeginPos = Frames[BeginFrame - 1].Next - 1;
+
+	for (size_t Pos = ChildPos + 1; Pos < Callees->Size(); Pos++)
+	{
+#ifdef CHILDDEBUG
+		std::cout << "MOVING " << *((*Callees)[Pos]->GetID()) << '\n';
+#endif
+		if ((*Callees)[Pos]->GetCaller() == BeginNode)
+		{
+			(*Callees)[Pos]->SetCaller(CallerOfBegin);
+		}
+	}
+
+	/* The frame of the caller continues directly behind the Pattern_Begin, i.e. with the moved nodes */
+	Callees->SpliceTail(ChildPos + 1, *CallerOfBegin->GetCallees(), BeginPos + 1);
+}
+
+int PatternNestingMatcher::GetLineDistance(CallTreeNode* Node, CallTreeNode* Caller)
+{
+	if (Node->GetNodeType() == Function_Decl)
+	{
+		return 0;
+	}
+
+	return Node->getLineNumber() - Caller->getLineNumber();
+}
+
+void PatternNestingMatcher::MarkNotSuited(CallTreeNode* BeginNode, CallTreeNode* EndNode)
+{
+	EndNode->setSuitedForNestingStatisticsTo(false);
+	BeginNode->setSuitedForNestingStatisticsTo(false);
+
+	std::cout << "PRINTING PATTERN THAT ARE NOT SUITED FOR STATISTICS WHICH NEED CLEAR NESTING" << '\n';
+	std::cout << "Pattern " << *EndNode->GetID() << " and " << *BeginNode->GetID() << " is not suited for statistics which need clear nesting of Pattern. " << '\n';
+	std::cout << "The first Pattern_Begin occurence before the Pattern_End of " << *EndNode->GetID() << " is " << *BeginNode->GetID() << '\n';
+}
@@ -0,0 +1,70 @@
+#include "PatternPairingValidator.h"
+#include "HPCParallelPattern.h"
+#include "HPCError.h"
+
+#include <iostream>
+
+PatternPairingValidator::PatternPairingValidator(const SourceFileTable& Files, bool StopAtFirstError) : Files(Files), StopAtFirstError(StopAtFirstError)
+{
+
+}
+
+void PatternPairingValidator::Begin(PatternCodeRegion* CodeRegion, StableLocation Loc, FunctionNode* Function)
+{
+	BeginIndices[CodeRegion->GetID()] = Begins.size();
+	Begins.push_back(BeginEntry{CodeRegion, Loc, Function, false});
+}
+
+PatternCodeRegion* PatternPairingValidator::End(const std::string& ID, StableLocation Loc, FunctionNode* Function)
+{
+	auto Index = BeginIndices.find(ID);
+
+	if (Index == BeginIndices.end())
+	{
+		Report(Loc, Function, "The Pattern_End of " + ID + " has no Pattern_Begin before it. The Pattern_Begin has to be in the same function or in a function that is defined before.");
+		return NULL;
+	}
+
+	BeginEntry& Entry = Begins[Index->second];
+
+	if (Entry.Closed)
+	{
+		Report(Loc, Function, "The Pattern_End of " + ID + " closes a code region that is already closed.");
+		return NULL;
+	}
+
+	Entry.Closed = true;
+	return Entry.CodeRegion;
+}
+
+bool PatternPairingValidator::Finish()
+{
+	for (BeginEntry& Entry : Begins)
+	{
+		if (!Entry.Closed)
+		{
+			Report(Entry.Loc, Entry.Function, "The Pattern_Begin of " + Entry.CodeRegion->GetID() + " has no Pattern_End after it.");
+		}
+	}
+
+	return NumErrors == 0;
+}
+
+void PatternPairingValidator::Clear()
+{
+	Begins.clear();
+	BeginIndices.clear();
+	NumErrors = 0;
+}
+
+void PatternPairingValidator::Report(StableLocation Loc, FunctionNode* Function, const std::string& Message)
+{
+	NumErrors++;
+
+	std::cout << "\033[31m" << Files.GetFileName(Loc.FileID) << ":" << Loc.Line << ": in " << Function->GetFnName() << ": " << Message << "\033[0m" << std::endl;
+
+	if (StopAtFirstError)
+	{
+		throw TerminateEarlyException();
+	}
+}
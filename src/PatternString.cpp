@@ -0,0 +1,87 @@
+#include "PatternString.h"
+#include "HPCError.h"
+
+#include <cctype>
+
+/**
+ * @brief A minimal tokenizer for the pattern begin string, which keeps track of the current position.
+ **/
+class PatternStringTokenizer
+{
+public:
+	explicit PatternStringTokenizer(llvm::StringRef Str) : Str(Str), Position(0)
+	{
+
+	}
+
+	void SkipWhitespace()
+	{
+		while (Position < Str.size() && std::isspace(static_cast<unsigned char>(Str[Position])))
+		{
+			Position++;
+		}
+	}
+
+	/**
+	 * @brief Reads the next token. The current position has to be at its first character.
+	 *
+	 * @param What The name of the token for the error message.
+	 *
+	 * @return The token.
+	 **/
+	llvm::StringRef ReadToken(const char* What)
+	{
+		size_t Begin = Position;
+
+		while (Position < Str.size() && std::isalnum(static_cast<unsigned char>(Str[Position])))
+		{
+			Position++;
+		}
+
+		if (Position < Str.size() && !std::isspace(static_cast<unsigned char>(Str[Position])))
+		{
+			throw PatternStringException(Str.str(), Position, std::string("invalid character '") + Str[Position] + "' in the " + What);
+		}
+
+		if (Begin == Position)
+		{
+			throw PatternStringException(Str.str(), Position, std::string("missing ") + What);
+		}
+
+		return Str.slice(Begin, Position);
+	}
+
+	void ExpectEnd()
+	{
+		SkipWhitespace();
+
+		if (Position < Str.size())
+		{
+			throw PatternStringException(Str.str(), Position, "unexpected text after the pattern identifier");
+		}
+	}
+
+private:
+	llvm::StringRef Str;
+
+	size_t Position;
+};
+
+PatternBeginString ParsePatternBeginString(llvm::StringRef Str)
+{
+	PatternStringTokenizer Tokenizer(Str);
+	PatternBeginString Result;
+
+	Tokenizer.SkipWhitespace();
+	Result.DesignSp = StrToDesignSpace(Tokenizer.ReadToken("design space").str());
+
+	Tokenizer.SkipWhitespace();
+	Result.PatternName = Tokenizer.ReadToken("pattern name").str();
+
+	Tokenizer.SkipWhitespace();
+	Result.PatternID = Tokenizer.ReadToken("pattern identifier").str();
+
+	Tokenizer.ExpectEnd();
+
+	return Result;
+}
@@ -0,0 +1,153 @@
+#include "PatternTransferComposition.h"
+#include "HPCParallelPattern.h"
+
+#include <algorithm>
+
+PatternTransferComposition::PatternTransferComposition(PatternGraph* Graph) : Graph(Graph), NextIndex(0)
+{
+
+}
+
+void PatternTransferComposition::Compose()
+{
+	for (FunctionNode* Function : Graph->GetAllFunctions())
+	{
+		if (States.find(Function) == States.end())
+		{
+			Traverse(Function);
+		}
+	}
+
+	/* The callees are completed first, so the callers are composed first in reverse order */
+	for (int Component = static_cast<int>(Components.size()) - 1; Component >= 0; Component--)
+	{
+		ComposeComponent(Component);
+	}
+}
+
+void PatternTransferComposition::Traverse(FunctionNode* Function)
+{
+	Enter(Function);
+
+	while (!Frames.empty())
+	{
+		Frame& Top = Frames.back();
+		const std::vector<PatternGraphNode*>& Children = Top.Function->GetChildren();
+
+		if (Top.Next == Children.size())
+		{
+			Leave();
+			continue;
+		}
+
+		/* Only the calls outside of all code regions are children of the function */
+		FunctionNode* Callee = clang::dyn_cast<FunctionNode>(Children[Top.Next]);
+		Top.Next++;
+
+		if (Callee == NULL)
+		{
+			continue;
+		}
+
+		auto State = States.find(Callee);
+
+		if (State == States.end())
+		{
+			/* Enter may grow the frames, so Top must not be used afterwards */
+			Enter(Callee);
+		}
+		else if (State->second.OnStack)
+		{
+			NodeState& TopState = States[Top.Function];
+			TopState.LowLink = std::min(TopState.LowLink, State->second.Index);
+		}
+	}
+}
+
+void PatternTransferComposition::Enter(FunctionNode* Function)
+{
+	States[Function] = NodeState{NextIndex, NextIndex, true, -1};
+	NextIndex++;
+	ComponentStack.push_back(Function);
+	Frames.push_back(Frame{Function, 0});
+}
+
+void PatternTransferComposition::Leave()
+{
+	FunctionNode* Function = Frames.back().Function;
+	Frames.pop_back();
+
+	NodeState& State = States[Function];
+
+	if (!Frames.empty())
+	{
+		NodeState& ParentState = States[Frames.back().Function];
+		ParentState.LowLink = std::min(ParentState.LowLink, State.LowLink);
+	}
+
+	if (State.LowLink != State.Index)
+	{
+		return;
+	}
+
+	/* Function is the root of a component, which consists of all functions above it on the stack */
+	size_t FirstIndex = ComponentStack.size();
+
+	do
+	{
+		FirstIndex--;
+	} while (ComponentStack[FirstIndex] != Function);
+
+	std::vector<FunctionNode*>::iterator First = ComponentStack.begin() + FirstIndex;
+	int Component = static_cast<int>(Components.size());
+
+	for (std::vector<FunctionNode*>::iterator Member = First; Member != ComponentStack.end(); Member++)
+	{
+		NodeState& MemberState = States[*Member];
+		MemberState.OnStack = false;
+		MemberState.Component = Component;
+	}
+
+	Components.emplace_back(First, ComponentStack.end());
+	ComponentStack.erase(First, ComponentStack.end());
+}
+
+void PatternTransferComposition::ComposeComponent(int Component)
+{
+	std::vector<FunctionNode*>& Members = Components[Component];
+	FunctionNode* Representative = Members.front();
+
+	for (FunctionNode* Member : Members)
+	{
+		for (PatternGraphNode* Parent : Member->GetParents())
+		{
+			if (PatternCodeRegion* CodeRegion = clang::dyn_cast<PatternCodeRegion>(Parent))
+			{
+				/* Called within a code region */
+				Representative->AddPatternParent(CodeRegion);
+			}
+			else if (FunctionNode* Caller = clang::dyn_cast<FunctionNode>(Parent))
+			{
+				/* Called outside of all regions, the regions around the calls of the caller apply.
+				 * Within a recursive cycle, the members share their pattern parents. */
+				if (States[Caller].Component != Component)
+				{
+					Representative->AddPatternParents(Caller->GetPatternParents());
+				}
+			}
+		}
+	}
+
+	for (FunctionNode* Member : Members)
+	{
+		if (Member != Representative)
+		{
+			Member->AddPatternParents(Representative->GetPatternParents());
+		}
+
+		if (!Member->HasNoPatternParents() && !Member->HasNoPatternChildren())
+		{
+			Member->registerPatChildrenToPatParents();
+		}
+	}
+}
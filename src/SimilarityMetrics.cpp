@@ -5,22 +5,26 @@
 
 SimilarityMeasure::SimilarityMeasure
 (
+	PatternGraph* myGraph,
 	PatternGraphNode* myRootNode,
 	GraphSearchDirection mySearchDirection,
 	SimilarityCriterion mySimilarityCriterion,
 	std::string mySimilarityLabel
 )
 :
+	HPCPatternStatistic(myGraph),
 	SimilarityLabel(mySimilarityLabel)
 {
 	switch(mySearchDirection){
 		case DIR_Children:{
 			TopDownCompositionVisitor Visitor(mySimilarityCriterion);
+			Visitor.SetSnapshot(myGraph -> GetSnapshot());
 			this -> PatternSequences = Visitor.CalculatePatternSequences(myRootNode);
  			break;
 		}
 		case DIR_Parents:{
 			BottomUpCompositionVisitor Visitor(mySimilarityCriterion);
+			Visitor.SetSnapshot(myGraph -> GetSnapshot());
 			this -> PatternSequences = Visitor.CalculatePatternSequences(myRootNode);
  			break;
 		}
@@ -0,0 +1,86 @@
+#include "SourceFileTable.h"
+
+SourceFileTable::SourceFileTable() : FileIDs(), FileNames(1)
+{
+
+}
+
+unsigned SourceFileTable::GetFileID(llvm::StringRef FileName)
+{
+	auto Entry = FileIDs.insert({FileName, (unsigned)FileNames.size()});
+
+	if (Entry.second)
+	{
+		FileNames.push_back(FileName.str());
+	}
+
+	return Entry.first->second;
+}
+
+std::string SourceFileTable::GetFileName(unsigned FileID) const
+{
+	if (FileID == StableLocation::InvalidFileID || FileID >= FileNames.size())
+	{
+		return "";
+	}
+
+	return FileNames[FileID];
+}
+
+void SourceFileTable::Clear()
+{
+	FileIDs.clear();
+	FileNames.resize(1);
+}
+
+StableLocationTranslator::StableLocationTranslator(const clang::SourceManager& SourceMan, SourceFileTable& Files) :
+	SourceMan(SourceMan), Files(Files), FileIDCache()
+{
+
+}
+
+StableLocation StableLocationTranslator::Translate(clang::SourceLocation Loc, bool WithLine)
+{
+	if (Loc.isInvalid())
+	{
+		return StableLocation();
+	}
+
+	std::pair<clang::FileID, unsigned> Decomposed = SourceMan.getDecomposedExpansionLoc(Loc);
+
+	unsigned StableFileID;
+	auto Cached = FileIDCache.find(Decomposed.first);
+
+	if (Cached != FileIDCache.end())
+	{
+		StableFileID = Cached->second;
+	}
+	else
+	{
+		/* Prefer the real path, so different spellings of the same file are merged */
+		const clang::FileEntry* Entry = SourceMan.getFileEntryForID(Decomposed.first);
+		StableFileID = StableLocation::InvalidFileID;
+
+		if (Entry != NULL)
+		{
+			llvm::StringRef Path = Entry->tryGetRealPathName();
+			StableFileID = Files.GetFileID(Path.empty() ? Entry->getName() : Path);
+		}
+
+		FileIDCache[Decomposed.first] = StableFileID;
+	}
+
+	if (StableFileID == StableLocation::InvalidFileID)
+	{
+		return StableLocation();
+	}
+
+	unsigned Line = WithLine ? SourceMan.getLineNumber(Decomposed.first, Decomposed.second) : 0;
+
+	return StableLocation(StableFileID, Decomposed.second, Line);
+}
+
+StableRange StableLocationTranslator::Translate(clang::SourceRange Range)
+{
+	return StableRange(Translate(Range.getBegin()), Translate(Range.getEnd()));
+}
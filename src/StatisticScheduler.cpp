@@ -0,0 +1,161 @@
+#include "StatisticScheduler.h"
+#include "HPCPatternStatistics.h"
+#include "Helpers.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <thread>
+
+StatisticScheduler::StatisticScheduler(unsigned NumThreads) : NumThreads(NumThreads), NumFinished(0)
+{
+	if (this->NumThreads == 0)
+	{
+		this->NumThreads = std::max(1u, std::thread::hardware_concurrency());
+	}
+}
+
+StatisticScheduler::TaskID StatisticScheduler::AddTask(std::function<void()> Work, const std::vector<TaskID>& Dependencies)
+{
+	TaskID ID = Tasks.size();
+
+	for (TaskID Dependency : Dependencies)
+	{
+		/* Tasks can only depend on earlier tasks, so the order in which they are added is a valid serial order */
+		Preconditions::CheckArgument<std::invalid_argument>(Dependency < ID, [&]() {
+			return "Task " + std::to_string(ID) + " depends on the unknown task " + std::to_string(Dependency);
+		});
+	}
+
+	for (TaskID Dependency : Dependencies)
+	{
+		Tasks[Dependency].Dependents.push_back(ID);
+	}
+
+	Tasks.push_back(Task{std::move(Work), {}, Dependencies.size()});
+	return ID;
+}
+
+StatisticScheduler::TaskID StatisticScheduler::AddStatistic(HPCPatternStatistic* Statistic, const std::vector<TaskID>& Dependencies)
+{
+	return AddTask([Statistic]() { Statistic->Calculate(); }, Dependencies);
+}
+
+StatisticScheduler::TaskID StatisticScheduler::AddPerPatternStatistic(PerPatternStatistic* Statistic, const std::vector<TaskID>& Dependencies)
+{
+	TaskID Begin = AddTask([Statistic]() { Statistic->BeginCalculation(); }, Dependencies);
+
+	/* The number of patterns is only known after BeginCalculation(), so each part computes its range when it runs */
+	size_t NumParts = NumThreads;
+	std::vector<TaskID> Parts;
+
+	for (size_t Part = 0; Part < NumParts; Part++)
+	{
+		Parts.push_back(AddTask([Statistic, Part, NumParts]() {
+			size_t NumPatterns = Statistic->GetNumPatterns();
+			Statistic->CalculatePatterns(NumPatterns * Part / NumParts, NumPatterns * (Part + 1) / NumParts);
+		}, {Begin}));
+	}
+
+	return AddTask([Statistic]() { Statistic->EndCalculation(); }, Parts);
+}
+
+void StatisticScheduler::Run()
+{
+	NumFinished = 0;
+	FirstException = nullptr;
+	OpenDependencies.resize(Tasks.size());
+	Ready.clear();
+
+	if (NumThreads == 1)
+	{
+		for (TaskID ID = 0; ID < Tasks.size() && !FirstException; ID++)
+		{
+			FirstException = RunTask(ID);
+		}
+	}
+	else
+	{
+		for (TaskID ID = 0; ID < Tasks.size(); ID++)
+		{
+			OpenDependencies[ID] = Tasks[ID].NumDependencies;
+
+			if (OpenDependencies[ID] == 0)
+			{
+				Ready.push_back(ID);
+			}
+		}
+
+		/* The calling thread is one of the threads of the pool */
+		std::vector<std::thread> Threads;
+
+		for (unsigned Thread = 1; Thread < NumThreads; Thread++)
+		{
+			Threads.emplace_back(&StatisticScheduler::Work, this);
+		}
+
+		Work();
+
+		for (std::thread& Thread : Threads)
+		{
+			Thread.join();
+		}
+	}
+
+	if (FirstException)
+	{
+		std::rethrow_exception(FirstException);
+	}
+}
+
+void StatisticScheduler::Work()
+{
+	std::unique_lock<std::mutex> Lock(Mutex);
+
+	while (NumFinished < Tasks.size())
+	{
+		if (Ready.empty())
+		{
+			Changed.wait(Lock);
+			continue;
+		}
+
+		TaskID ID = Ready.front();
+		Ready.pop_front();
+		bool Skip = FirstException != nullptr;
+
+		Lock.unlock();
+		std::exception_ptr Exception = Skip ? nullptr : RunTask(ID);
+		Lock.lock();
+
+		if (Exception && !FirstException)
+		{
+			FirstException = Exception;
+		}
+
+		NumFinished++;
+
+		for (TaskID Dependent : Tasks[ID].Dependents)
+		{
+			if (--OpenDependencies[Dependent] == 0)
+			{
+				Ready.push_back(Dependent);
+			}
+		}
+
+		Changed.notify_all();
+	}
+}
+
+std::exception_ptr StatisticScheduler::RunTask(TaskID ID)
+{
+	try
+	{
+		Tasks[ID].Work();
+	}
+	catch (...)
+	{
+		return std::current_exception();
+	}
+
+	return nullptr;
+}
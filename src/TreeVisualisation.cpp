@@ -1,36 +1,427 @@
 #include "TreeVisualisation.h"
-#include <tuple>
+#include "visitor/DepthFirstTraversal.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/DenseSet.h"
+#include <algorithm>
 #include <iostream>
+#include <string>
+#include <vector>
 //#define LOCDEBUG
 
+/**
+ * The numbers of the subtrees of a compact tree. A shared subtree is printed in full once, labelled with its number,
+ * and every further occurrence is printed as a back-reference to the number.
+ * A subtree that is cut by the maximum depth while it is printed loses its number again, so the next occurrence
+ * is expanded once more instead of referring to the truncated copy.
+ */
+template <typename NodeType> class SubtreeNumbering
+{
+public:
+	/* The number of the subtree below the node, 0 if it has no number yet */
+	unsigned Lookup(NodeType Node) const
+	{
+		return Numbers.lookup(Node);
+	}
+
+	/* Numbers the subtree below the node and returns its label */
+	std::string Assign(NodeType Node)
+	{
+		unsigned& Number = Numbers[Node];
+
+		if (Number == 0)
+		{
+			Number = ++LastNumber;
+		}
+
+		return " #" + std::to_string(Number);
+	}
+
+	/* Called when the printing of a numbered subtree begins */
+	void Open(NodeType Node)
+	{
+		OpenSubtrees.push_back(OpenSubtree{Node, false});
+	}
+
+	/* Called when the children of a node within the open subtrees are not printed because of the maximum depth */
+	void MarkTruncated()
+	{
+		if (!OpenSubtrees.empty())
+		{
+			OpenSubtrees.back().Truncated = true;
+		}
+	}
+
+	/**
+	 * Called when the printing of a node has finished. If the node is the innermost open subtree, it is closed
+	 * and loses its number if it has been truncated. The enclosing subtree is truncated as well in that case.
+	 * Returns true if the node lost its number.
+	 */
+	bool Close(NodeType Node)
+	{
+		if (OpenSubtrees.empty() || OpenSubtrees.back().Node != Node)
+		{
+			return false;
+		}
+
+		bool Truncated = OpenSubtrees.back().Truncated;
+		OpenSubtrees.pop_back();
+
+		if (Truncated)
+		{
+			Numbers.erase(Node);
+			MarkTruncated();
+		}
+
+		return Truncated;
+	}
+
+	static std::string BackReference(unsigned Number)
+	{
+		return " -> see #" + std::to_string(Number);
+	}
+
+private:
+	struct OpenSubtree
+	{
+		NodeType Node;
+		bool Truncated;
+	};
+
+	llvm::DenseMap<NodeType, unsigned> Numbers;
+
+	/* The numbered subtrees on the current path, innermost last */
+	std::vector<OpenSubtree> OpenSubtrees;
+
+	unsigned LastNumber = 0;
+};
+
+/**
+ * Prints every node of the pattern graph with an indent according to its depth.
+ * In the only pattern tree, the pattern children of the code regions are followed instead of the children.
+ * In a compact tree, the children of a node are printed only below its first occurrence, see SubtreeNumbering.
+ */
+class CallTreeVisualisation::PatternGraphPrinter : public DepthFirstTraversal<PatternGraphPrinter, PatternGraphNode*>
+{
+public:
+	PatternGraphPrinter(int maxdepth, bool myOnlyPattern, bool myCompact, unsigned myMaxChildren) :
+		DepthFirstTraversal(maxdepth), DisplayDepth(maxdepth), OnlyPattern(myOnlyPattern), Compact(myCompact), MaxChildren(myMaxChildren)
+	{
+
+	}
+
+	bool PreVisit(PatternGraphNode* Node, int depth)
+	{
+		if (!clang::isa<FunctionNode>(Node) && !clang::isa<PatternCodeRegion>(Node))
+		{
+			return false;
+		}
+
+		std::string Label;
+		bool Expand = true;
+
+		/* Only the nodes whose children would be printed are numbered */
+		if (Compact && depth < DisplayDepth && GetNumChildren(Node) != 0)
+		{
+			if (unsigned Number = Numbers.Lookup(Node))
+			{
+				Label = SubtreeNumbering<PatternGraphNode*>::BackReference(Number);
+				Expand = false;
+			}
+			else
+			{
+				Label = Numbers.Assign(Node);
+				Numbers.Open(Node);
+			}
+		}
+		else if (Compact && depth >= DisplayDepth && GetNumChildren(Node) != 0)
+		{
+			Numbers.MarkTruncated();
+		}
+
+		if (FunctionNode* FnCall = clang::dyn_cast<FunctionNode>(Node))
+		{
+			PrintFunction(FnCall, depth, Label);
+		}
+		else
+		{
+			PrintPattern(clang::cast<PatternCodeRegion>(Node), depth, Label);
+		}
+
+		return Expand;
+	}
+
+	void PostVisit(PatternGraphNode* Node, int depth)
+	{
+		if (depth < DisplayDepth && MaxChildren != 0 && GetNumChildren(Node) > MaxChildren)
+		{
+			PrintOmittedChildren(GetNumChildren(Node) - MaxChildren, depth + 1);
+		}
+
+		if (Compact)
+		{
+			Numbers.Close(Node);
+		}
+	}
+
+	size_t GetNumNeighbours(PatternGraphNode* Node)
+	{
+		return LimitChildren(GetNumChildren(Node), MaxChildren);
+	}
+
+	PatternGraphNode* GetNeighbour(PatternGraphNode* Node, size_t Index)
+	{
+		if (PatternCodeRegion* CodeRegion = GetOnlyPatternRegion(Node))
+		{
+			return CodeRegion->GetOnlyPatternChildren()[Index];
+		}
+
+		return Node->GetChildren()[Index];
+	}
+
+private:
+	/* The code region whose pattern children are followed, NULL if the children of the node are followed */
+	PatternCodeRegion* GetOnlyPatternRegion(PatternGraphNode* Node)
+	{
+		return OnlyPattern ? clang::dyn_cast<PatternCodeRegion>(Node) : NULL;
+	}
+
+	/* The number of children that are followed, without the limit */
+	size_t GetNumChildren(PatternGraphNode* Node)
+	{
+		if (PatternCodeRegion* CodeRegion = GetOnlyPatternRegion(Node))
+		{
+			return CodeRegion->GetOnlyPatternChildren().size();
+		}
+
+		return Node->GetChildren().size();
+	}
+
+	int DisplayDepth;
+
+	bool OnlyPattern;
+
+	bool Compact;
+
+	unsigned MaxChildren;
+
+	SubtreeNumbering<PatternGraphNode*> Numbers;
+};
+
+/**
+ * Prints the nodes of the call tree. The callees of a function declaration are printed at the depth of the declaration,
+ * the end of a pattern at the depth of its begin.
+ * Only the nodes down to the maximum depth are expanded, see DepthFirstTraversal.
+ * In the only pattern tree, the declarations whose subtree contains no pattern are not expanded, see CallTreeSummaries.
+ * In a compact tree, the declaration of a function is expanded below its first call only, see SubtreeNumbering.
+ * The compact tree and the limit of the callees only apply if the function calls are printed, i.e. not to the only pattern tree.
+ */
+class CallTreeVisualisation::CallTreePrinter : public DepthFirstTraversal<CallTreePrinter, CallTreeNode*>
+{
+public:
+	CallTreePrinter(int maxdepth, bool myOnlyPattern, bool myCompact, unsigned myMaxChildren, CallTreeSummaries& mySummaries) :
+		DepthFirstTraversal(maxdepth), DisplayDepth(maxdepth), OnlyPattern(myOnlyPattern),
+		Compact(myCompact && !myOnlyPattern), MaxChildren(myOnlyPattern ? 0 : myMaxChildren), Summaries(mySummaries)
+	{
+
+	}
+
+	bool PreVisit(CallTreeNode* ClTrNode, int depth)
+	{
+		CallTreeNodeType nodeTypeOfClTr = ClTrNode->GetNodeType();
+		if(OnlyPattern && nodeTypeOfClTr == Function_Decl && !Summaries.Get(ClTrNode).HasPatterns()){
+			return false;
+		}
+
+		if(Compact && nodeTypeOfClTr == Function_Decl){
+			/* Another call already expanded the declaration and printed a back-reference to it */
+			if(Numbers.Lookup(ClTrNode) != 0 && Expanded.count(ClTrNode)){
+				return false;
+			}
+			Expanded.insert(ClTrNode);
+
+			if(Numbers.Lookup(ClTrNode) != 0){
+				Numbers.Open(ClTrNode);
+			}
+		}
+
+		if(Compact && nodeTypeOfClTr == Function){
+			return PrintCompactCall(ClTrNode, depth);
+		}
+
+		if(Compact && GetNeighbourDepth(ClTrNode, depth) > DisplayDepth && ClTrNode->GetCallees()->Size() != 0){
+			Numbers.MarkTruncated();
+		}
+
+		if(nodeTypeOfClTr == Pattern_Begin){
+			int& BeginDepth = BeginDepths[ClTrNode];
+			BeginDepth = std::max(BeginDepth, depth);
+		}
+
+		if(OnlyPattern){
+			if(nodeTypeOfClTr == Pattern_End||nodeTypeOfClTr == Pattern_Begin){
+				if(nodeTypeOfClTr == Pattern_End){
+					PrintIndent(GetEndDepth(ClTrNode));
+					#ifdef LOCDEBUG
+						std::cout <<"Adress of CallTreeNode: "<< ClTrNode << '\n';
+					#endif
+				}
+				else{
+					PrintIndent(depth);
+				}
+				ClTrNode->print();
+			}
+		}
+		else if(nodeTypeOfClTr!= Function_Decl){
+			if(nodeTypeOfClTr != Pattern_End){
+				PrintIndent(depth);
+			}
+			else{
+				PrintIndent(GetEndDepth(ClTrNode));
+			}
+			ClTrNode->print();
+			#ifdef LOCDEBUG
+				std::cout <<"Adress of CallTreeNode: "<< ClTrNode << '\n';
+			#endif
+		}
+
+		#ifdef DEBUG
+			std::cout << "\033[36m" << *ClTrNode->GetID() << ":\33[33m" << std::endl;
+
+			if(ClTrNode->GetCaller())
+				std::cout << "Caller:" << *(ClTrNode->GetCaller()->GetID())<<" Type: "<< ClTrNode->GetCaller()->GetNodeType() << std::endl;
+			  std::cout << "Callees:" << std::endl;
+				for(CallTreeNode* Callee : *ClTrNode->GetCallees())
+				{
+					std::cout << *Callee->GetID() << " Type: " << Callee->GetNodeType() << std::endl;
+				}
+		#endif
+		return true;
+	}
+
+	int GetNeighbourDepth(CallTreeNode* ClTrNode, int depth)
+	{
+		if(ClTrNode->GetNodeType() == Function_Decl){
+			return depth;
+		}
+
+		return depth + 1;
+	}
+
+	void PostVisit(CallTreeNode* ClTrNode, int depth)
+	{
+		size_t NumCallees = ClTrNode->GetCallees()->Size();
+		int CalleeDepth = GetNeighbourDepth(ClTrNode, depth);
+
+		if(CalleeDepth <= DisplayDepth && MaxChildren != 0 && NumCallees > MaxChildren){
+			PrintOmittedChildren(NumCallees - MaxChildren, CalleeDepth);
+		}
+
+		/* A truncated declaration is expanded again at its next call */
+		if(Compact && Numbers.Close(ClTrNode)){
+			Expanded.erase(ClTrNode);
+		}
+	}
+
+	size_t GetNumNeighbours(CallTreeNode* ClTrNode)
+	{
+		return LimitChildren(ClTrNode->GetCallees()->Size(), MaxChildren);
+	}
+
+	CallTreeNode* GetNeighbour(CallTreeNode* ClTrNode, size_t Index)
+	{
+		return (*ClTrNode->GetCallees())[Index];
+	}
+
+private:
+	/**
+	 * Prints a function call with the numbers of the declarations that are expanded below it
+	 * and the back-references to the declarations that are already expanded.
+	 * Returns false if no declaration is left to expand below the call.
+	 */
+	bool PrintCompactCall(CallTreeNode* ClTrNode, int depth)
+	{
+		std::string Label;
+		bool Expand = false;
+
+		/* A virtual call has a declaration for each overrider */
+		for(CallTreeNode* Callee : *ClTrNode->GetCallees()){
+			unsigned Number = Numbers.Lookup(Callee);
+
+			if(Number != 0 && Expanded.count(Callee)){
+				Label += SubtreeNumbering<CallTreeNode*>::BackReference(Number);
+				continue;
+			}
+
+			Expand = true;
+
+			/* The callees of the declaration are printed at the depth of the declaration */
+			if(Callee->GetNodeType() == Function_Decl && Callee->GetCallees()->Size() != 0){
+				if(depth < DisplayDepth){
+					Label += Numbers.Assign(Callee);
+				}
+				else{
+					Numbers.MarkTruncated();
+				}
+			}
+		}
+
+		PrintIndent(depth);
+		ClTrNode->print(Label);
+		return Expand;
+	}
+
+	/* The depth of the corresponding Pattern_Begin, 0 if it has not been printed */
+	int GetEndDepth(CallTreeNode* EndNode)
+	{
+		return BeginDepths.lookup(EndNode->getCorrespCallTreeNodeRelation());
+	}
+
+	int DisplayDepth;
+
+	bool OnlyPattern;
+
+	bool Compact;
+
+	unsigned MaxChildren;
+
+	CallTreeSummaries& Summaries;
+
+	SubtreeNumbering<CallTreeNode*> Numbers;
+
+	/* The declarations that have been entered in a compact tree */
+	llvm::DenseSet<CallTreeNode*> Expanded;
+
+	/* The largest depth at which each Pattern_Begin has been printed so far */
+	llvm::DenseMap<CallTreeNode*, int> BeginDepths;
+};
+
 /**
  * @brief Prints the call tree recursively, beginning with the main function.
  *
  * @param maxdepth The maximum recursion (i.e., output depth)
+ * @param Graph The pattern graph that is printed.
  **/
-void CallTreeVisualisation::PrintRelationTree(int maxdepth, bool onlyPattern)
+void CallTreeVisualisation::PrintRelationTree(int maxdepth, PatternGraph* Graph, bool onlyPattern, bool compact, unsigned maxchildren)
 {
 	std::cout << "\n RELATION TREE VISUALISATION \n";
-	PatternGraphNode* RootNode = PatternGraph::GetInstance()->GetRootNode();
+	PatternGraphNode* RootNode = Graph->GetRootNode();
 	if(onlyPattern){
-			PrintOnlyPatternTree(maxdepth);
+			PrintOnlyPatternTree(maxdepth, Graph, compact, maxchildren);
 	}
 	else{
 		if (FunctionNode* Func = clang::dyn_cast<FunctionNode>(RootNode))
 		{
-			PrintFunction(Func, 0, maxdepth);
+			PatternGraphPrinter(maxdepth, false, compact, maxchildren).Traverse(Func);
 		}
 		else if (PatternCodeRegion* CodeRegion = clang::dyn_cast<PatternCodeRegion>(RootNode))
 		{
-			PrintPattern(CodeRegion, 0, maxdepth);
+			PatternGraphPrinter(maxdepth, false, compact, maxchildren).Traverse(CodeRegion);
 		}
 	}
 }
 
-void CallTreeVisualisation::PrintCallTree(int maxdepth, CallTree* CalTre, bool onlyPattern){
+void CallTreeVisualisation::PrintCallTree(int maxdepth, CallTree* CalTre, bool onlyPattern, bool compact, unsigned maxchildren){
 	std::cout << "\n CALL TREE VISUALISATION \n";
-	std::vector<std::tuple<int, CallTreeNode*>> CallTreeHelp;
-	int CallTreeHelpKey = 0;
 	CallTreeNode* currentNode = CalTre->getRoot();
 #ifdef DEBUG
 	const Identification* currentIdent = currentNode->GetID();
@@ -39,14 +430,17 @@ void CallTreeVisualisation::PrintCallTree(int maxdepth, CallTree* CalTre, bool o
 #ifdef LOCDEBUG
 	std::cout << currentNode << '\n';
 #endif
-	PrintCallTreeRecursively (CallTreeHelpKey, CallTreeHelp, currentNode, 0, maxdepth, onlyPattern);
+	CallTreePrinter(maxdepth, onlyPattern, compact, maxchildren, CalTre->GetSummaries()).Traverse(currentNode);
 }
 
-void CallTreeVisualisation::PrintOnlyPatternTree(int maxdepth)
+void CallTreeVisualisation::PrintOnlyPatternTree(int maxdepth, PatternGraph* Graph, bool compact, unsigned maxchildren)
 {
-	//PatternGraph::GetInstance()->SetOnlyPatternRootNodes();
+	//Graph->SetOnlyPatternRootNodes();
 
-	for(PatternCodeRegion* OnlyPatRootNode : PatternGraph::GetInstance()->GetAllPatternCodeRegions())
+	/* One printer for all root nodes, so the numbers of a compact tree are unique */
+	PatternGraphPrinter Printer(maxdepth, true, compact, maxchildren);
+
+	for(PatternCodeRegion* OnlyPatRootNode : Graph->GetAllPatternCodeRegions())
 	//hier selbst raussortieren welche Pattern als RootNode gelten(Pattern die in der Main sind und keine Eltern haben)
 	{
 #ifdef DEBUG
@@ -57,12 +451,12 @@ void CallTreeVisualisation::PrintOnlyPatternTree(int maxdepth)
 
 		PatternCodeRegion* CodeRegion = clang::dyn_cast<PatternCodeRegion>(OnlyPatRootNode);
 		if(CodeRegion->isInMain && CodeRegion->HasNoPatternParents()){
-			PrintRecursiveOnlyPattern(CodeRegion,0,maxdepth);
+			Printer.Traverse(CodeRegion);
 		}
 	}
 
 #ifdef DEBUG
-	for(FunctionNode* FuncNode : PatternGraph::GetInstance()->GetAllFunctions())
+	for(FunctionNode* FuncNode : Graph->GetAllFunctions())
 	{
 		if(!FuncNode->HasNoPatternParents()||!FuncNode->HasNoPatternChildren())
 		std::cout << "NEUE FUNKTION" << '\n';
@@ -75,143 +469,33 @@ void CallTreeVisualisation::PrintOnlyPatternTree(int maxdepth)
 }
 
 /**
- * @brief Prints a pattern in the pattern tree with spacing according to the recursion depth.
+ * @brief Prints a pattern in the pattern tree with spacing according to its depth.
  *
  * @param CodeRegion The code region from which the pattern is printed.
- * @param depth The current depth of recursion.
- * @param maxdepth The maximum depth of recursion.
+ * @param depth The depth of the code region.
+ * @param Label Printed at the end of the line.
  **/
-void CallTreeVisualisation::PrintPattern(PatternCodeRegion* CodeRegion, int depth, int maxdepth)
+void CallTreeVisualisation::PrintPattern(PatternCodeRegion* CodeRegion, int depth, const std::string& Label)
 {
-	if (depth > maxdepth)
-	{
-		return;
-	}
-
 	PrintIndent(depth);
 
 	HPCParallelPattern* Pattern = CodeRegion->GetPatternOccurrence()->GetPattern();
 	std::cout << "\033[36m" << Pattern->GetDesignSpaceStr() << ":\33[33m " << Pattern->GetPatternName() << "\33[0m";
 
-	std::cout << "(" << CodeRegion->GetPatternOccurrence()->GetID() << ")" << std::endl;
-
-	for (PatternGraphNode* Child : CodeRegion->GetChildren())
-	{
-		if (FunctionNode* FnCall = clang::dyn_cast<FunctionNode>(Child))
-		{
-			PrintFunction(FnCall, depth + 1, maxdepth);
-		}
-		else if (PatternCodeRegion* CodeRegion = clang::dyn_cast<PatternCodeRegion>(Child))
-		{
-			PrintPattern(CodeRegion, depth + 1, maxdepth);
-		}
-	}
+	std::cout << "(" << CodeRegion->GetPatternOccurrence()->GetID() << ")" << Label << std::endl;
 }
 
 /**
  * @brief Prints a function in the pattern tree with indent.
  *
  * @param FnCall Function call.
- * @param depth Current recursion depth.
- * @param maxdepth Maximum recursion depth.
+ * @param depth The depth of the function.
+ * @param Label Printed at the end of the line.
  **/
-void CallTreeVisualisation::PrintFunction(FunctionNode* FnCall, int depth, int maxdepth)
-{
-	if (depth > maxdepth)
-	{
-		return;
-	}
-		PrintIndent(depth);
-		std::cout << "\033[31m" << FnCall->GetFnName() << "\033[0m" << " (Hash: " << FnCall->GetHash() << ")" << std::endl;
-	for (PatternGraphNode* Child : FnCall->GetChildren())
-	{
-		if (FunctionNode* FnCall = clang::dyn_cast<FunctionNode>(Child))
-		{
-			PrintFunction(FnCall, depth + 1, maxdepth);
-		}
-		else if (PatternCodeRegion* CodeRegion = clang::dyn_cast<PatternCodeRegion>(Child))
-		{
-			PrintPattern(CodeRegion, depth + 1, maxdepth);
-		}
-	}
-}
-
-void CallTreeVisualisation::PrintRecursiveOnlyPattern(PatternCodeRegion* CodeRegion,int depth,int maxdepth)
+void CallTreeVisualisation::PrintFunction(FunctionNode* FnCall, int depth, const std::string& Label)
 {
-	if (depth > maxdepth)
-	{
-		return;
-	}
 	PrintIndent(depth);
-	HPCParallelPattern* Pattern = CodeRegion->GetPatternOccurrence()->GetPattern();
-	std::cout << "\033[36m" << Pattern->GetDesignSpaceStr() << ":\33[33m " << Pattern->GetPatternName() << "\33[0m";
-		std::cout << "(" << CodeRegion->GetPatternOccurrence()->GetID() << ")" << std::endl;
-
-	for (PatternGraphNode* Child : CodeRegion->GetOnlyPatternChildren())
-	{
-		PatternCodeRegion* CodeRegion = clang::dyn_cast<PatternCodeRegion>(Child);
-		PrintRecursiveOnlyPattern(CodeRegion, depth + 1, maxdepth);
-	}
-}
-
-void CallTreeVisualisation::PrintCallTreeRecursively(int &HelpKey, std::vector<std::tuple<int, CallTreeNode*>> &CallTreeHelp, CallTreeNode* ClTrNode, int depth, int maxdepth, bool onlyPattern){
-	if(depth > maxdepth){
-		return;
-	}
-	CallTreeNodeType nodeTypeOfClTr = ClTrNode->GetNodeType();
-	if(nodeTypeOfClTr == Pattern_Begin){
-		CallTreeHelp.push_back(std::make_tuple(depth, ClTrNode));
-	}
-
-	if(onlyPattern){
-		if(nodeTypeOfClTr == Pattern_End||nodeTypeOfClTr == Pattern_Begin){
-			if(nodeTypeOfClTr == Pattern_End){
-				int depthForEnd = searchDepthInCallTreeHelp(CallTreeHelp, ClTrNode);
-				PrintIndent(depthForEnd);
-				#ifdef LOCDEBUG
-					std::cout <<"Adress of CallTreeNode: "<< ClTrNode << '\n';
-				#endif
-			}
-			else{
-				PrintIndent(depth);
-			}
-			ClTrNode->print();
-		}
-	}
-	else if(nodeTypeOfClTr!= Function_Decl){
-		if(nodeTypeOfClTr != Pattern_End){
-			PrintIndent(depth);
-		}
-		else{
-			int depthForEnd = searchDepthInCallTreeHelp(CallTreeHelp, ClTrNode);
-			PrintIndent(depthForEnd);
-		}
-		ClTrNode->print();
-		#ifdef LOCDEBUG
-			std::cout <<"Adress of CallTreeNode: "<< ClTrNode << '\n';
-		#endif
-	}
-
-	#ifdef DEBUG
-		std::cout << "\033[36m" << *ClTrNode->GetID() << ":\33[33m" << std::endl;
-
-		if(ClTrNode->GetCaller())
-			std::cout << "Caller:" << *(ClTrNode->GetCaller()->GetID())<<" Type: "<< ClTrNode->GetCaller()->GetNodeType() << std::endl;
-		  std::cout << "Callees:" << std::endl;
-			for(CallTreeNode* Callee : *ClTrNode->GetCallees())
-			{
-				std::cout << *Callee->GetID() << " Type: " << Callee->GetNodeType() << std::endl;
-			}
-	#endif
-	for(const auto &CalleePair : *(ClTrNode->GetCallees())){
-		CallTreeNode* Callee = CalleePair.second;
-		if(nodeTypeOfClTr == Function_Decl){
-				PrintCallTreeRecursively(HelpKey, CallTreeHelp, Callee, depth, maxdepth, onlyPattern);
-		}
-		else{
-			PrintCallTreeRecursively(HelpKey, CallTreeHelp, Callee, depth + 1, maxdepth, onlyPattern);
-		}
-	}
+	std::cout << "\033[31m" << FnCall->GetFnName() << "\033[0m" << " (Hash: " << FnCall->GetHash() << ")" << Label << std::endl;
 }
 
 /**
@@ -236,19 +520,23 @@ void CallTreeVisualisation::PrintIndent(int depth)
 	}
 }
 
-int CallTreeVisualisation::searchDepthInCallTreeHelp(std::vector<std::tuple<int, CallTreeNode*>> &CallTreeHelp, CallTreeNode* EndNode){
-	if(EndNode->GetNodeType()!= Pattern_End){
-		std::cout << "This function should be only used for CallTreeNodes of the Type Pattern_End. Returnning 0 by default." << '\n';
-		return 0;
-	}
-	int largestDepth = 0;
-	int depthOfNode;
-	for(std::tuple<int, CallTreeNode*> tup : CallTreeHelp){
-		if(std::get<1>(tup) == EndNode->getCorrespCallTreeNodeRelation()){
-			depthOfNode = std::get<0>(tup);
-			if(largestDepth <= depthOfNode)
-				largestDepth = depthOfNode;
-		}
+size_t CallTreeVisualisation::LimitChildren(size_t numchildren, unsigned maxchildren)
+{
+	if(maxchildren != 0 && numchildren > maxchildren){
+		return maxchildren;
 	}
-	return largestDepth;
+
+	return numchildren;
+}
+
+/**
+ * @brief Prints a placeholder for the children that are not printed.
+ *
+ * @param numomitted The number of children that are left out.
+ * @param depth The depth of the children.
+ **/
+void CallTreeVisualisation::PrintOmittedChildren(size_t numomitted, int depth)
+{
+	PrintIndent(depth);
+	std::cout << "... " << numomitted << " more" << std::endl;
 }
@@ -1,10 +1,11 @@
 #include "clang/ASTDelegatorConsumer.h"
 
 ASTDelegatorConsumer::ASTDelegatorConsumer(
-		clang::ASTContext *myContext
+		clang::ASTContext *myContext,
+		AnalysisContext* myAnalysis
 ) :
-		myFunctionPointAnalysisVisitor(myContext),
-		myHalsteadVisitor(myContext){
+		myFunctionPointAnalysisVisitor(myContext, &myAnalysis -> GetGraph()),
+		myHalsteadVisitor(myContext, &myAnalysis -> GetGraph()){
 }
 
 void ASTDelegatorConsumer::HandleTranslationUnit(clang::ASTContext &myContext){
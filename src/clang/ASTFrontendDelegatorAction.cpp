@@ -7,5 +7,5 @@ std::unique_ptr<clang::ASTConsumer> ASTFrontendDelegatorAction::CreateASTConsume
 )
 {
 	static_cast<void>(myFile); //Avoid unused parameter warning
-	return (std::unique_ptr<clang::ASTConsumer>(new ASTDelegatorConsumer(&myCompiler.getASTContext())));
+	return (std::unique_ptr<clang::ASTConsumer>(new ASTDelegatorConsumer(&myCompiler.getASTContext(), Analysis)));
 }
@@ -1,7 +1,7 @@
 #include "clang/ASTInstrumentationConsumer.h"
 
-ASTInstrumentationConsumer::ASTInstrumentationConsumer(clang::ASTContext *myContext) :
-		myInstrumentationVisitor(myContext){
+ASTInstrumentationConsumer::ASTInstrumentationConsumer(clang::ASTContext *myContext, AnalysisContext* myAnalysis) :
+		myInstrumentationVisitor(myContext, myAnalysis){
 }
 
 void ASTInstrumentationConsumer::HandleTranslationUnit(clang::ASTContext &myContext){
@@ -7,5 +7,5 @@ std::unique_ptr<clang::ASTConsumer> ASTFrontendInstrumentationAction::CreateASTC
 )
 {
 	static_cast<void>(myFile); //Avoid unused parameter warning
-	return (std::unique_ptr<clang::ASTConsumer>(new ASTInstrumentationConsumer(&myCompiler.getASTContext())));
+	return (std::unique_ptr<clang::ASTConsumer>(new ASTInstrumentationConsumer(&myCompiler.getASTContext(), Analysis)));
 }
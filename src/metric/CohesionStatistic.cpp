@@ -4,33 +4,47 @@
 #include <iostream>
 #include <fstream>
 
+CohesionStatistic::CohesionStatistic(PatternGraph* myGraph) : PerPatternStatistic(myGraph){}
+
 CohesionStatistic::~CohesionStatistic(){}
 
-void CohesionStatistic::Calculate(){
-	for(HPCParallelPattern* Pattern : PatternGraph::GetInstance() -> GetAllPatterns()){
-		CohesionCounter CohesionCounter = CalculateConnectivity(Pattern);
-		CalculateTCC(CohesionCounter);
-		CalculateLCC(CohesionCounter);
-		CohesionMap.emplace(Pattern, CohesionCounter);
-	}
+void CohesionStatistic::PrepareResults(size_t NumPatterns){
+	Results.assign(NumPatterns, CohesionCounter());
+}
+
+void CohesionStatistic::CalculatePattern(size_t Index, HPCParallelPattern* Pattern){
+	CohesionCounter CohesionCounter = CalculateConnectivity(Pattern);
+	CalculateTCC(CohesionCounter);
+	CalculateLCC(CohesionCounter);
+	Results[Index] = std::move(CohesionCounter);
+}
+
+void CohesionStatistic::StoreResult(size_t Index, HPCParallelPattern* Pattern){
+	CohesionMap.emplace(Pattern, std::move(Results[Index]));
 }
 
 CohesionStatistic::CohesionCounter CohesionStatistic::CalculateConnectivity(HPCParallelPattern* Pattern){
 	CohesionCounter CohesionCounter;
+	const PatternGraphSnapshot& Snapshot = GetSnapshot();
 
 	//Root Code Regions
 	for(PatternCodeRegion* CodeRegion : Pattern -> GetCodeRegions()){
+		//Code regions that are not part of the frozen graph have no edges to follow
+		if(!Snapshot.Contains(CodeRegion))
+			continue;
+
 		ConnectedPatternCounter ConnectedPatternCounter;
+		ConnectedPatternCounter.SetSnapshot(&Snapshot);
 
 		//Children are directly connected
-		for(PatternCodeRegion* Child : CodeRegion -> GetOnlyPatternChildren()){
+		for(PatternGraphSnapshot::NodeIndex Child : Snapshot.GetOnlyPatternChildren(CodeRegion -> GetSnapshotIndex())){
 			CohesionCounter.DirectlyConnectedPatterns.emplace(
-					Child -> GetPatternOccurrence() -> GetPattern()
+					Snapshot.GetPattern(Snapshot.GetPatternIndex(Child))
 			);
 
 			//Grand children are the first indirectly connected patterns
-			for(PatternCodeRegion* GrandChild : Child -> GetOnlyPatternChildren()){
-				GrandChild -> Accept(&ConnectedPatternCounter);
+			for(PatternGraphSnapshot::NodeIndex GrandChild : Snapshot.GetOnlyPatternChildren(Child)){
+				ConnectedPatternCounter.TraverseNode(Snapshot.GetNode(GrandChild));
 			}
 		}
 
@@ -45,13 +59,13 @@ CohesionStatistic::CohesionCounter CohesionStatistic::CalculateConnectivity(HPCP
 }
 
 void CohesionStatistic::CalculateTCC(CohesionCounter& CohesionCounter){
-	double TotalNumberOfPatterns = PatternGraph::GetInstance() -> GetAllPatterns().size();
+	double TotalNumberOfPatterns = this -> Graph -> GetAllPatterns().size();
 
 	CohesionCounter.TCC = CohesionCounter.DirectlyConnectedPatterns.size() / TotalNumberOfPatterns;
 }
 
 void CohesionStatistic::CalculateLCC(CohesionCounter& CohesionCounter){
-	double TotalNumberOfPatterns = PatternGraph::GetInstance() -> GetAllPatterns().size();
+	double TotalNumberOfPatterns = this -> Graph -> GetAllPatterns().size();
 	double NumberOfConnectedPatterns = (CohesionCounter.IndirectlyConnectedPatterns.size() + CohesionCounter.DirectlyConnectedPatterns.size());
 
 	CohesionCounter.LCC = NumberOfConnectedPatterns / TotalNumberOfPatterns;
@@ -6,17 +6,24 @@
 #define VALUE_ADJUSTMENT_FACTOR_OFFSET (0.65)
 #define VALUE_ADJUSTMENT_FACTOR_PERCENT (0.01)
 
+FunctionPointAnalysisStatistic::FunctionPointAnalysisStatistic(PatternGraph* myGraph) : PerPatternStatistic(myGraph){}
+
 FunctionPointAnalysisStatistic::~FunctionPointAnalysisStatistic(){}
 
-void FunctionPointAnalysisStatistic::Calculate(){
-	for(HPCParallelPattern* Pattern : PatternGraph::GetInstance() -> GetAllPatterns()){
-		FunctionPointCounter Counter = Calculate(Pattern);
-		FunctionPointMap.emplace(Pattern, Counter);
-	}
+void FunctionPointAnalysisStatistic::PrepareResults(size_t NumPatterns){
+	Results.assign(NumPatterns, FunctionPointCounter());
+}
+
+void FunctionPointAnalysisStatistic::CalculatePattern(size_t Index, HPCParallelPattern* Pattern){
+	Results[Index] = Calculate(Pattern);
+}
+
+void FunctionPointAnalysisStatistic::StoreResult(size_t Index, HPCParallelPattern* Pattern){
+	FunctionPointMap.emplace(Pattern, Results[Index]);
 }
 
 void FunctionPointAnalysisStatistic::Print(){
-	for(HPCParallelPattern* Pattern : PatternGraph::GetInstance() -> GetAllPatterns()){
+	for(HPCParallelPattern* Pattern : this -> Graph -> GetAllPatterns()){
 		FunctionPointCounter Counter = FunctionPointMap[Pattern];
 		std::cout << "Pattern " << Pattern -> GetPatternName() << " has:" << std::endl;
 
@@ -63,7 +70,7 @@ void FunctionPointAnalysisStatistic::FunctionPointAnalysisStatistic::CSVExport(s
 
 	File << IO::CSVPrintLine("PatterName", "UFP", "VAF", "FPC");
 
-	for(HPCParallelPattern* Pattern : PatternGraph::GetInstance() -> GetAllPatterns()){
+	for(HPCParallelPattern* Pattern : this -> Graph -> GetAllPatterns()){
 		FunctionPointCounter Counter = FunctionPointMap[Pattern];
 		File << IO::CSVPrintLine(
 				Pattern -> GetPatternName(),
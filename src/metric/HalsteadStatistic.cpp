@@ -5,11 +5,20 @@
 #include <iostream>
 #include <fstream>
 
+HalsteadStatistic::HalsteadStatistic(PatternGraph* myGraph) : PerPatternStatistic(myGraph){}
+
 HalsteadStatistic::~HalsteadStatistic(){}
 
-void HalsteadStatistic::Calculate(){
-	for(HPCParallelPattern* Pattern : PatternGraph::GetInstance() -> GetAllPatterns())
-		Calculate(Pattern);
+void HalsteadStatistic::PrepareResults(size_t NumPatterns){
+	Results.assign(NumPatterns, HalsteadCounter());
+}
+
+void HalsteadStatistic::CalculatePattern(size_t Index, HPCParallelPattern* Pattern){
+	Results[Index] = Calculate(Pattern);
+}
+
+void HalsteadStatistic::StoreResult(size_t Index, HPCParallelPattern* Pattern){
+	HalsteadMap.emplace(Pattern, Results[Index]);
 }
 
 void HalsteadStatistic::Print(){
@@ -72,7 +81,7 @@ void HalsteadStatistic::CSVExport(std::string FileName){
 	File.close();
 }
 
-void HalsteadStatistic::Calculate(HPCParallelPattern* Pattern){
+HalsteadStatistic::HalsteadCounter HalsteadStatistic::Calculate(HPCParallelPattern* Pattern){
 	HalsteadCounter HalsteadCounter;
 
 	HalsteadCounter.Vocabulary = CalculateProgramVocabulary(Pattern);
@@ -84,7 +93,7 @@ void HalsteadStatistic::Calculate(HPCParallelPattern* Pattern){
 	HalsteadCounter.TimeRequiredToProgram = CalculateTimeRequiredToProgram(Pattern);
 	HalsteadCounter.NumberOfDeliveredBugs = CalculateNumberOfDeliveredBugs(Pattern);
 
-	HalsteadMap.emplace(Pattern, HalsteadCounter);
+	return (HalsteadCounter);
 }
 
 int HalsteadStatistic::CalculateProgramVocabulary(HPCParallelPattern* Pattern){
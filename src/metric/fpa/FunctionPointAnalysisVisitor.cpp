@@ -6,14 +6,14 @@
 #include "metric/fpa/visitor/UnaryOperatorVisitor.h"
 #include "metric/fpa/visitor/AbstractConditionalOperatorVisitor.h"
 
-FunctionPointAnalysisVisitor::FunctionPointAnalysisVisitor(clang::ASTContext* myContext) :
-		ClangPatternVisitor(myContext),
+FunctionPointAnalysisVisitor::FunctionPointAnalysisVisitor(clang::ASTContext* myContext, PatternGraph* myGraph) :
+		ClangPatternVisitor(myContext, myGraph),
 		Context(myContext){
 }
 
 bool FunctionPointAnalysisVisitor::TraverseDeclRefExpr(clang::DeclRefExpr* Node){
 	if(!CodeRegions.empty()){
-		DeclRefExprVisitorImplementation Visitor(Context, CodeRegions.back() -> GetSourceRange());
+		DeclRefExprVisitorImplementation Visitor(Context, Graph, CodeRegions.back() -> GetSourceRange());
 		Visitor.TraverseDeclRefExpr(Node);
 
 		for(FunctionPoint* FunctionPoint : Visitor.FunctionPoints)
@@ -25,7 +25,7 @@ bool FunctionPointAnalysisVisitor::TraverseDeclRefExpr(clang::DeclRefExpr* Node)
 
 bool FunctionPointAnalysisVisitor::TraverseVarDecl(clang::VarDecl* Node){
 	if(!CodeRegions.empty()){
-		VarDeclVisitor Visitor(Context, CodeRegions.back() -> GetSourceRange());
+		VarDeclVisitor Visitor(Context, Graph, CodeRegions.back() -> GetSourceRange());
 		Visitor.TraverseVarDecl(Node);
 
 		for(FunctionPoint* FunctionPoint : Visitor.FunctionPoints)
@@ -36,7 +36,7 @@ bool FunctionPointAnalysisVisitor::TraverseVarDecl(clang::VarDecl* Node){
 
 bool FunctionPointAnalysisVisitor::TraverseUnaryOperator(clang::UnaryOperator* Node){
 	if(!CodeRegions.empty()){
-		UnaryOperatorVisitor Visitor(Context, CodeRegions.back() -> GetSourceRange());
+		UnaryOperatorVisitor Visitor(Context, Graph, CodeRegions.back() -> GetSourceRange());
 		Visitor.TraverseUnaryOperator(Node);
 
 		for(FunctionPoint* FunctionPoint : Visitor.FunctionPoints)
@@ -50,11 +50,11 @@ bool FunctionPointAnalysisVisitor::TraverseBinaryOperator(clang::BinaryOperator*
 	if(!CodeRegions.empty()){
 		std::vector<FunctionPoint*> FunctionPoints;
 		if(Node ->isCompoundAssignmentOp() || Node -> isAssignmentOp()){
-			AssignmentOperatorVisitor Visitor(Context, CodeRegions.back() -> GetSourceRange());
+			AssignmentOperatorVisitor Visitor(Context, Graph, CodeRegions.back() -> GetSourceRange());
 			Visitor.TraverseBinaryOperator(Node);
 			FunctionPoints = Visitor.FunctionPoints;
 		}else{
-			BinaryOperatorVisitor Visitor(Context, CodeRegions.back() -> GetSourceRange());
+			BinaryOperatorVisitor Visitor(Context, Graph, CodeRegions.back() -> GetSourceRange());
 			Visitor.TraverseBinaryOperator(Node);
 			FunctionPoints = Visitor.FunctionPoints;
 		}
@@ -68,7 +68,7 @@ bool FunctionPointAnalysisVisitor::TraverseBinaryOperator(clang::BinaryOperator*
 
 bool FunctionPointAnalysisVisitor::TraverseAbstractConditionalOperator(clang::AbstractConditionalOperator* Node){
 	if(!CodeRegions.empty()){
-		AbstractConditionalOperatorVisitor Visitor(Context, CodeRegions.back() -> GetSourceRange());
+		AbstractConditionalOperatorVisitor Visitor(Context, Graph, CodeRegions.back() -> GetSourceRange());
 
 		//No idea why TraverseAbstractConditionalOperator doesn't exist
 		//¯\_(ツ)_/¯
@@ -86,9 +86,9 @@ void FunctionPointAnalysisVisitor::VisitPatternCodeRegion(PatternCodeRegion* Pat
 }
 
 void FunctionPointAnalysisVisitor::EndVisitPatternCodeRegion(PatternCodeRegion* PatternCodeRegion){
-	Preconditions::CheckArgument(
+	Preconditions::CheckArgument<std::out_of_range>(
 		!CodeRegions.empty(),
-		std::out_of_range("Tried to remove " + PatternCodeRegion -> GetPatternOccurrence() -> GetPattern() -> GetPatternName() + " but stack was empty.")
+		[PatternCodeRegion](){ return "Tried to remove " + PatternCodeRegion -> GetPatternOccurrence() -> GetPattern() -> GetPatternName() + " but stack was empty."; }
 	);
 
 	CodeRegions.pop_back();
@@ -1,10 +1,11 @@
 #include "metric/fpa/PrettyPrinter.h"
 #include "metric/fpa/visitor/AbstractConditionalOperatorVisitor.h"
 #include "metric/fpa/visitor/TransactionalFunctionVisitor.h"
+#include "PatternGraph.h"
 #include "metric/fpa/ExternalInput.h"
 
-AbstractConditionalOperatorVisitor::AbstractConditionalOperatorVisitor(clang::ASTContext* myContext, clang::SourceRange mySourceRange):
-	DeclRefExprVisitor(myContext, mySourceRange),
+AbstractConditionalOperatorVisitor::AbstractConditionalOperatorVisitor(clang::ASTContext* myContext, PatternGraph* myGraph, StableRange mySourceRange):
+	DeclRefExprVisitor(myContext, myGraph, mySourceRange),
 	IsFirstOccurrence(true){
 }
 
@@ -23,7 +24,7 @@ bool AbstractConditionalOperatorVisitor::VisitAbstractConditionalOperator(clang:
 		OverlapsWithEnvironment(Node -> getFalseExpr())
 	)
 	{
-		FunctionPoint* FunctionPoint = new ExternalInput(
+		FunctionPoint* FunctionPoint = this -> Graph -> GetArena().Create<ExternalInput>(
 				Visitor.det,
 				Visitor.ftr,
 				PrettyPrinter::PrintPretty(Node)
@@ -1,11 +1,12 @@
 #include "metric/fpa/PrettyPrinter.h"
 #include "metric/fpa/visitor/AssignmentOperatorVisitor.h"
 #include "metric/fpa/visitor/TransactionalFunctionVisitor.h"
+#include "PatternGraph.h"
 #include "metric/fpa/ExternalInput.h"
 #include "metric/fpa/ExternalOutput.h"
 
-AssignmentOperatorVisitor::AssignmentOperatorVisitor(clang::ASTContext* myContext, clang::SourceRange mySourceRange):
-	DeclRefExprVisitor(myContext, mySourceRange){
+AssignmentOperatorVisitor::AssignmentOperatorVisitor(clang::ASTContext* myContext, PatternGraph* myGraph, StableRange mySourceRange):
+	DeclRefExprVisitor(myContext, myGraph, mySourceRange){
 }
 
 bool AssignmentOperatorVisitor::VisitBinaryOperator(clang::BinaryOperator* Node){
@@ -16,7 +17,7 @@ bool AssignmentOperatorVisitor::VisitBinaryOperator(clang::BinaryOperator* Node)
 		//e.g. x = y
 		//where x is inside and y outside the pattern
 		if(OverlapsWithPattern(Node -> getLHS()) && OverlapsWithEnvironment(Node -> getRHS())){
-			FunctionPoint* FunctionPoint = new ExternalInput(
+			FunctionPoint* FunctionPoint = this -> Graph -> GetArena().Create<ExternalInput>(
 					Visitor.det,
 					Visitor.ftr,
 					PrettyPrinter::PrintPretty(Node)
@@ -26,7 +27,7 @@ bool AssignmentOperatorVisitor::VisitBinaryOperator(clang::BinaryOperator* Node)
 		//e.g. x = ...
 		//where is is outside the pattern
 		}else if(OverlapsWithEnvironment(Node -> getLHS())){
-			FunctionPoint* FunctionPoint = new ExternalOutput(
+			FunctionPoint* FunctionPoint = this -> Graph -> GetArena().Create<ExternalOutput>(
 					Visitor.det,
 					Visitor.ftr,
 					PrettyPrinter::PrintPretty(Node)
@@ -1,10 +1,11 @@
 #include "metric/fpa/PrettyPrinter.h"
 #include "metric/fpa/visitor/BinaryOperatorVisitor.h"
 #include "metric/fpa/visitor/TransactionalFunctionVisitor.h"
+#include "PatternGraph.h"
 #include "metric/fpa/ExternalInput.h"
 
-BinaryOperatorVisitor::BinaryOperatorVisitor(clang::ASTContext* myContext, clang::SourceRange mySourceRange):
-	DeclRefExprVisitor(myContext, mySourceRange),
+BinaryOperatorVisitor::BinaryOperatorVisitor(clang::ASTContext* myContext, PatternGraph* myGraph, StableRange mySourceRange):
+	DeclRefExprVisitor(myContext, myGraph, mySourceRange),
 	IsFirstOccurrence(true){
 }
 
@@ -18,7 +19,7 @@ bool BinaryOperatorVisitor::VisitBinaryOperator(clang::BinaryOperator* Node){
 	Visitor.TraverseStmt(Node);
 
 	if(OverlapsWithEnvironment(Node -> getLHS()) || OverlapsWithEnvironment(Node -> getRHS())){
-		FunctionPoint* FunctionPoint = new ExternalInput(
+		FunctionPoint* FunctionPoint = this -> Graph -> GetArena().Create<ExternalInput>(
 				Visitor.det,
 				Visitor.ftr,
 				PrettyPrinter::PrintPretty(Node)
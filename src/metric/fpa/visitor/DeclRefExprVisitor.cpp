@@ -1,5 +1,5 @@
 #include "metric/fpa/visitor/DeclRefExprVisitor.h"
 
-DeclRefExprVisitorImplementation::DeclRefExprVisitorImplementation(clang::ASTContext* myContext, clang::SourceRange mySourceRange):
-	DeclRefExprVisitor(myContext, mySourceRange){
+DeclRefExprVisitorImplementation::DeclRefExprVisitorImplementation(clang::ASTContext* myContext, PatternGraph* myGraph, StableRange mySourceRange):
+	DeclRefExprVisitor(myContext, myGraph, mySourceRange){
 }
@@ -1,10 +1,11 @@
 #include "metric/fpa/PrettyPrinter.h"
 #include "metric/fpa/visitor/UnaryOperatorVisitor.h"
 #include "metric/fpa/visitor/TransactionalFunctionVisitor.h"
+#include "PatternGraph.h"
 #include "metric/fpa/ExternalInput.h"
 
-UnaryOperatorVisitor::UnaryOperatorVisitor(clang::ASTContext* myContext, clang::SourceRange mySourceRange):
-	DeclRefExprVisitor(myContext, mySourceRange),
+UnaryOperatorVisitor::UnaryOperatorVisitor(clang::ASTContext* myContext, PatternGraph* myGraph, StableRange mySourceRange):
+	DeclRefExprVisitor(myContext, myGraph, mySourceRange),
 	IsFirstOccurrence(true){
 }
 
@@ -21,13 +22,13 @@ bool UnaryOperatorVisitor::VisitUnaryOperator(clang::UnaryOperator* Node){
 		FunctionPoint* FunctionPoint;
 
 		if(Node -> isIncrementDecrementOp()){
-			FunctionPoint = new ExternalOutput(
+			FunctionPoint = this -> Graph -> GetArena().Create<ExternalOutput>(
 				Visitor.det,
 				Visitor.ftr,
 				PrettyPrinter::PrintPretty(Node)
 			);
 		}else{
-			FunctionPoint = new ExternalInput(
+			FunctionPoint = this -> Graph -> GetArena().Create<ExternalInput>(
 				Visitor.det,
 				Visitor.ftr,
 				PrettyPrinter::PrintPretty(Node)
@@ -2,11 +2,12 @@
 #include "metric/fpa/visitor/VarDeclVisitor.h"
 #include "metric/fpa/visitor/DataFunctionVisitor.h"
 #include "metric/fpa/visitor/TransactionalFunctionVisitor.h"
+#include "PatternGraph.h"
 #include "metric/fpa/InternalLogicalFile.h"
 #include "metric/fpa/ExternalInput.h"
 
-VarDeclVisitor::VarDeclVisitor(clang::ASTContext* myContext, clang::SourceRange mySourceRange):
-	DeclRefExprVisitor(myContext, mySourceRange){
+VarDeclVisitor::VarDeclVisitor(clang::ASTContext* myContext, PatternGraph* myGraph, StableRange mySourceRange):
+	DeclRefExprVisitor(myContext, myGraph, mySourceRange){
 }
 
 bool VarDeclVisitor::VisitVarDecl(clang::VarDecl* Node){
@@ -20,7 +21,7 @@ void VarDeclVisitor::HandleDataFunction(clang::VarDecl* Node){
 	DataFunctionVisitor Visitor(Context);
 	Visitor.TraverseVarDecl(Node);
 
-	FunctionPoint* FunctionPoint = new InternalLogicalFile(
+	FunctionPoint* FunctionPoint = this -> Graph -> GetArena().Create<InternalLogicalFile>(
 			Visitor.det,
 			Visitor.ret,
 			PrettyPrinter::PrintPretty(Node)
@@ -37,7 +38,7 @@ void VarDeclVisitor::HandleTransactionalFunction(clang::VarDecl* Node){
 	Visitor.TraverseVarDecl(Node);
 
 	if(OverlapsWithEnvironment(Node ->getInit())){
-		FunctionPoint* FunctionPoint = new ExternalInput(
+		FunctionPoint* FunctionPoint = this -> Graph -> GetArena().Create<ExternalInput>(
 				Visitor.det,
 				Visitor.ftr,
 				PrettyPrinter::PrintPretty(Node)
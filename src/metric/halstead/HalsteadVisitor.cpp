@@ -1,7 +1,7 @@
 #include "metric/halstead/HalsteadVisitor.h"
 
-HalsteadVisitor::HalsteadVisitor(clang::ASTContext* myContext) :
-		ClangPatternVisitor(myContext){
+HalsteadVisitor::HalsteadVisitor(clang::ASTContext* myContext, PatternGraph* myGraph) :
+		ClangPatternVisitor(myContext, myGraph){
 }
 
 bool HalsteadVisitor::shouldVisitImplicitCode() const{
@@ -123,9 +123,9 @@ void HalsteadVisitor::VisitPatternCodeRegion(PatternCodeRegion* CodeRegion){
 }
 
 void HalsteadVisitor::EndVisitPatternCodeRegion(PatternCodeRegion* CodeRegion){
-	Preconditions::CheckArgument(
+	Preconditions::CheckArgument<std::out_of_range>(
 		!CodeRegions.empty(),
-		std::out_of_range("Tried to remove " + CodeRegion -> GetPatternOccurrence() -> GetPattern() -> GetPatternName() + " but stack was empty.")
+		[CodeRegion](){ return "Tried to remove " + CodeRegion -> GetPatternOccurrence() -> GetPattern() -> GetPatternName() + " but stack was empty."; }
 	);
 
 	CodeRegions.pop_back();
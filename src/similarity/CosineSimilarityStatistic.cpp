@@ -1,11 +1,12 @@
 #include "similarity/CosineSimilarityStatistic.h"
 
 CosineSimilarityStatistic::CosineSimilarityStatistic(
+	PatternGraph* myGraph,
 	PatternGraphNode* myRootPattern,
 	GraphSearchDirection mySearchDirection,
 	SimilarityCriterion mySimilarityCriterion
 )
-	: SimilarityMeasure(myRootPattern, mySearchDirection, mySimilarityCriterion, "Cosine Similarity"){
+	: SimilarityMeasure(myGraph, myRootPattern, mySearchDirection, mySimilarityCriterion, "Cosine Similarity"){
 }
 
 float CosineSimilarityStatistic::ComputeSimilarity(PatternSequencePointer Left, PatternSequencePointer Right){
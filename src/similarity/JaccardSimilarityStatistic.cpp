@@ -1,11 +1,12 @@
 #include "similarity/JaccardSimilarityStatistic.h"
 
 JaccardSimilarityStatistic::JaccardSimilarityStatistic(
+	PatternGraph* myGraph,
 	PatternGraphNode* myRootPattern,
 	GraphSearchDirection mySearchDirection,
 	SimilarityCriterion mySimilarityCriterion
 )
-	: SimilarityMeasure(myRootPattern, mySearchDirection, mySimilarityCriterion, "Jaccard Similarity"){
+	: SimilarityMeasure(myGraph, myRootPattern, mySearchDirection, mySimilarityCriterion, "Jaccard Similarity"){
 }
 
 float JaccardSimilarityStatistic::ComputeSimilarity(PatternSequencePointer Left, PatternSequencePointer Right){
@@ -1,11 +1,12 @@
 #include "similarity/OverlapCoefficientStatistic.h"
 
 OverlapCoefficientStatistic::OverlapCoefficientStatistic(
+	PatternGraph* myGraph,
 	PatternGraphNode* myRootPattern,
 	GraphSearchDirection mySearchDirection,
 	SimilarityCriterion mySimilarityCriterion
 )
-	: SimilarityMeasure(myRootPattern, mySearchDirection, mySimilarityCriterion, "Overlap Coefficient"){
+	: SimilarityMeasure(myGraph, myRootPattern, mySearchDirection, mySimilarityCriterion, "Overlap Coefficient"){
 }
 
 float OverlapCoefficientStatistic::ComputeSimilarity(PatternSequencePointer Left, PatternSequencePointer Right){
@@ -1,11 +1,12 @@
 #include "similarity/WeightedJaccardSimilarityStatistic.h"
 
 WeightedJaccardSimilarityStatistic::WeightedJaccardSimilarityStatistic(
+	PatternGraph* myGraph,
 	PatternGraphNode* myRootPattern,
 	GraphSearchDirection mySearchDirection,
 	SimilarityCriterion mySimilarityCriterion
 )
-	: SimilarityMeasure(myRootPattern, mySearchDirection, mySimilarityCriterion, "Weighted Jaccard Similarity"){
+	: SimilarityMeasure(myGraph, myRootPattern, mySearchDirection, mySimilarityCriterion, "Weighted Jaccard Similarity"){
 }
 
 float WeightedJaccardSimilarityStatistic::ComputeSimilarity(PatternSequencePointer Left, PatternSequencePointer Right){
@@ -12,7 +12,7 @@ void BottomUpCompositionVisitor::VisitPatternCodeRegion(PatternCodeRegion* Node)
 }
 
 void BottomUpCompositionVisitor::EndVisitPatternCodeRegion(PatternCodeRegion* Node){
-	Preconditions::CheckArgument(!SequenceCodeRegions.empty(), std::out_of_range("Missing Pattern_Begin for "+Node -> GetID()));
+	Preconditions::CheckArgument<std::out_of_range>(!SequenceCodeRegions.empty(), [Node](){ return "Missing Pattern_Begin for "+Node -> GetID(); });
 
 	//The first endVisit indicates that the code region is indeed a leaf
 	if(PatternCodeRegionIsLeaf){
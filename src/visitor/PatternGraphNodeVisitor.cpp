@@ -1,13 +1,13 @@
 #include "visitor/PatternGraphNodeVisitor.h"
 #include "HPCParallelPattern.h"
+#include "PatternGraph.h"
 
 void PatternGraphNodeVisitor::VisitPatternCodeRegion(PatternCodeRegion* Node){
 	static_cast<void>(Node); //Avoid unused parameter warning
 }
 
 void PatternGraphNodeVisitor::TraversePatternCodeRegion(PatternCodeRegion* Node){
-	for(auto Child : Node -> GetChildren())
-		Child -> Accept(this);
+	TraverseChildren(Node);
 }
 
 void PatternGraphNodeVisitor::EndVisitPatternCodeRegion(PatternCodeRegion* Node){
@@ -34,8 +34,7 @@ void PatternGraphNodeVisitor::VisitFunctionNode(FunctionNode* Node){
 void PatternGraphNodeVisitor::TraverseFunctionNode(FunctionNode* Node){
 	//VisitedNodes.emplace returns true if it's the first time the node is traversed
 	if(VisitedNodes.emplace(Node -> GetHash()).second)
-		for(auto Child : Node -> GetChildren())
-				Child -> Accept(this);
+		TraverseChildren(Node);
 }
 void PatternGraphNodeVisitor::EndVisitFunctionNode(FunctionNode* Node){
 	static_cast<void>(Node); //Avoid unused parameter warning
@@ -45,3 +44,14 @@ void PatternGraphNodeVisitor::HandleFunctionNode(FunctionNode* Node){
 	TraverseFunctionNode(Node);
 	EndVisitFunctionNode(Node);
 }
+
+void PatternGraphNodeVisitor::TraverseChildren(PatternGraphNode* Node){
+	//Once the graph is frozen, the children are read from the snapshot instead of copying the child vector
+	if(Snapshot != NULL && Snapshot -> Contains(Node)){
+		for(PatternGraphSnapshot::NodeIndex Child : Snapshot -> GetChildren(Node -> GetSnapshotIndex()))
+			Snapshot -> GetNode(Child) -> Accept(this);
+	}else{
+		for(auto Child : Node -> GetChildren())
+			Child -> Accept(this);
+	}
+}
@@ -0,0 +1,31 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+
+#include "PatternInstrumentation.h"
+
+void CloseOuter();
+void CloseInner();
+
+int main(int argc, char* argv[])
+{
+	PatternInstrumentation::Pattern_Begin("FindingConcurrency TypeQualifiers TQ1");
+	PatternInstrumentation::Pattern_Begin("FindingConcurrency TypeQualifiers TQ2");
+	//TQ1 ends in CloseOuter while TQ2 is still open, so TQ1 and TQ2 are not clearly nested
+	CloseOuter();
+	PatternInstrumentation::Pattern_End("TQ2");
+	//TQ3 ends in CloseInner and is nested correctly. It is moved behind TQ1, because TQ1 has already ended.
+	PatternInstrumentation::Pattern_Begin("FindingConcurrency TypeQualifiers TQ3");
+	CloseInner();
+	return 0;
+}
+
+void CloseOuter()
+{
+	PatternInstrumentation::Pattern_End("TQ1");
+}
+
+void CloseInner()
+{
+	PatternInstrumentation::Pattern_End("TQ3");
+}
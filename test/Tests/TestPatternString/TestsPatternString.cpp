@@ -0,0 +1,8 @@
+#include "TestsPatternString.h"
+#include "PatternInstrumentation.h"
+
+void Test::Reduce(){
+  //A line break separates the tokens like any other whitespace
+  PatternInstrumentation::Pattern_Begin("ImplementationMechanism\n  Barrier2 B2");
+  PatternInstrumentation::Pattern_End("B2");
+}
@@ -0,0 +1,8 @@
+class Test;
+
+
+class Test{
+
+public:
+  static void Reduce();
+};
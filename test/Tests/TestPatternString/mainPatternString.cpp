@@ -0,0 +1,20 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+
+#include "PatternInstrumentation.h"
+#include "TestsPatternString.h"
+
+
+int main(int argc, char* argv[])
+{
+	PatternInstrumentation::Pattern_Begin("FindingConcurrency TypeQualifiers TQ1");
+	//Leading, trailing and repeated whitespace between the tokens is ignored
+	PatternInstrumentation::Pattern_Begin("   AlgorithmStructure    Reduction   R1   ");
+	Test::Reduce();
+	PatternInstrumentation::Pattern_End("R1");
+	PatternInstrumentation::Pattern_Begin("\tSupportingStructure\tLoopParallelism\tLP1\t");
+	PatternInstrumentation::Pattern_End("LP1");
+	PatternInstrumentation::Pattern_End("TQ1");
+	return 0;
+}
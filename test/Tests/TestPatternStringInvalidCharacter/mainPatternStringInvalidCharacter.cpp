@@ -0,0 +1,14 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+
+#include "PatternInstrumentation.h"
+
+
+int main(int argc, char* argv[])
+{
+	//Tokens consist of letters and digits only, the hyphen is reported
+	PatternInstrumentation::Pattern_Begin("FindingConcurrency Type-Qualifiers TQ1");
+	PatternInstrumentation::Pattern_End("TQ1");
+	return 0;
+}
@@ -0,0 +1,14 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+
+#include "PatternInstrumentation.h"
+
+
+int main(int argc, char* argv[])
+{
+	//The pattern identifier is missing, it is reported at the end of the string
+	PatternInstrumentation::Pattern_Begin("FindingConcurrency TypeQualifiers");
+	PatternInstrumentation::Pattern_End("TQ1");
+	return 0;
+}
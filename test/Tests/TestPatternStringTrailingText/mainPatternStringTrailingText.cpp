@@ -0,0 +1,14 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+
+#include "PatternInstrumentation.h"
+
+
+int main(int argc, char* argv[])
+{
+	//Only three tokens are allowed, the fourth one is reported
+	PatternInstrumentation::Pattern_Begin("FindingConcurrency TypeQualifiers TQ1 TQ2");
+	PatternInstrumentation::Pattern_End("TQ1");
+	return 0;
+}
@@ -0,0 +1,15 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+
+#include "PatternInstrumentation.h"
+
+
+int main(int argc, char* argv[])
+{
+	//TQ1 is never ended, TQ2 is nested correctly
+	PatternInstrumentation::Pattern_Begin("FindingConcurrency TypeQualifiers TQ1");
+	PatternInstrumentation::Pattern_Begin("FindingConcurrency TypeQualifiers TQ2");
+	PatternInstrumentation::Pattern_End("TQ2");
+	return 0;
+}